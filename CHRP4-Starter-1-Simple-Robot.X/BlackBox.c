@@ -0,0 +1,106 @@
+/*==============================================================================
+ File: BlackBox.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) persistent RAM black box recorder functions
+
+ Functions to record the last few control loop states in a ring buffer that
+ survives resets, and to read it back after a reset. These functions are only
+ compiled when BLACKBOX is defined. Include the BlackBox.h file in your main
+ program to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "BlackBox.h"        // Include black box constant & function definitions
+
+#ifdef BLACKBOX
+
+unsigned char blackbox_cause;       // PCON reset flags at boot
+
+// Ring buffer and header, not cleared by the C startup code
+__persistent blackbox_t blackbox_log[BLACKBOX_RECORDS];
+__persistent unsigned int blackbox_magic;   // BLACKBOX_MAGIC if valid
+__persistent unsigned char blackbox_head;   // Next record to write
+__persistent unsigned char blackbox_used;   // Records written (up to the size)
+__persistent unsigned char blackbox_check;  // Head ^ used ^ BLACKBOX_KEY
+
+// Save and re-arm the reset flags, and check that the header is intact.
+bool blackbox_boot(void)
+{
+    blackbox_cause = PCON;
+    PCON = 0b00011111;          // Clear STKOVF/STKUNF, set the other flags
+    if(blackbox_magic != BLACKBOX_MAGIC ||
+       blackbox_check != (blackbox_head ^ blackbox_used ^ BLACKBOX_KEY) ||
+       blackbox_head >= BLACKBOX_RECORDS || blackbox_used > BLACKBOX_RECORDS)
+    {
+        blackbox_start();       // Power-up or damaged - start empty
+        return (false);
+    }
+    return (blackbox_used != 0);
+}
+
+// Empty the ring buffer and make the header valid.
+void blackbox_start(void)
+{
+    blackbox_head = 0;
+    blackbox_used = 0;
+    blackbox_check = BLACKBOX_KEY;
+    blackbox_magic = BLACKBOX_MAGIC;
+}
+
+// Store one record, then update the header. The check byte is written last,
+// so a reset part way through a header update is detected (and the recording
+// discarded) rather than giving a wrong record order.
+void blackbox_record(unsigned char mode, unsigned char sensorL,
+                     unsigned char sensorR, unsigned char motorL,
+                     unsigned char motorR, unsigned int period)
+{
+    blackbox_t *record = &blackbox_log[blackbox_head];
+    unsigned char head;
+
+    record->sensorL = sensorL;
+    record->sensorR = sensorR;
+    record->motorL = motorL;
+    record->motorR = motorR;
+    period >>= 2;
+    if(period > 127)
+    {
+        period = 127;
+    }
+    record->status = (unsigned char)(mode << 7) | (unsigned char)period;
+
+    head = blackbox_head + 1;
+    if(head == BLACKBOX_RECORDS)
+    {
+        head = 0;
+    }
+    blackbox_head = head;
+    if(blackbox_used != BLACKBOX_RECORDS)
+    {
+        blackbox_used ++;
+    }
+    blackbox_check = head ^ blackbox_used ^ BLACKBOX_KEY;
+}
+
+// Return the number of records.
+unsigned char blackbox_count(void)
+{
+    return (blackbox_used);
+}
+
+// Copy a record, counting from the oldest.
+void blackbox_read(unsigned char index, blackbox_t *record)
+{
+    unsigned char i = blackbox_head + (BLACKBOX_RECORDS - blackbox_used) + index;
+
+    if(i >= BLACKBOX_RECORDS)
+    {
+        i -= BLACKBOX_RECORDS;
+    }
+    *record = blackbox_log[i];
+}
+
+#endif
@@ -0,0 +1,127 @@
+/*==============================================================================
+ File: BlackBox.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) persistent RAM black box recorder constant and function
+ definitions.
+
+ Black box enable section:
+ Black box code is only compiled when BLACKBOX is defined, either by removing
+ the comment from the definition below or by adding BLACKBOX to the project's
+ XC8 compiler 'Define macros' setting.
+
+ Recording:
+ While the robot is line following, a scheduler task calls blackbox_record()
+ every BLACKBOX_PERIOD ticks to add a record to a ring buffer that holds the
+ last BLACKBOX_RECORDS records. Each record is five bytes: the two sensor
+ levels and two motor commands (the same values that are sent in telemetry
+ frames, see Telemetry.h), and a status byte holding the mode (bit 7) and the
+ control loop period in units of 4 TMR0 counts (bits 0-6, limited to 127).
+ Recording takes well under 100 instruction cycles (8 us) per record, so the
+ black box can be left on in competition builds. The default 24 records use
+ 120 bytes of RAM and cover the last 131 ms. The sensor tables already use
+ half of the RAM, so a longer history needs fewer records per second (a
+ longer BLACKBOX_PERIOD) rather than more records.
+
+ Surviving resets:
+ The ring buffer and its header are __persistent, so the C startup code does
+ not clear them, and they keep their contents through every reset that does not
+ remove power: SW1 (MCLR), RESET(), a watchdog timeout, a stack overflow, or a
+ brown-out that does not drop too far (unless the USB bootloader stays in
+ programming mode, which uses the RAM for itself). The header holds a magic
+ number, the ring buffer index and record count, and a check byte made from the
+ index and count, which is updated with each record. At power-up, the RAM holds
+ random values, which are very unlikely to pass the magic number and check byte
+ tests. blackbox_boot() validates the header, and records the reset cause from
+ the PCON register (bits are 0 for the reset that happened, except STKOVF and
+ STKUNF which are 1) before re-arming its flags. The recording stays valid
+ until blackbox_start() starts a new one, so it can be read after any number of
+ resets until the robot follows a line again.
+
+ Dump on boot:
+ When telemetry is available, the main program streams a valid recording at
+ boot, before the mode selector starts. It first sends a statistics frame
+ with the ID BLACKBOX_ID holding the record count, the reset cause, and
+ BLACKBOX_PERIOD, and then sends each record as a telemetry frame, oldest
+ first. The tools/chrp4-telemetry.py decoder marks these frames as black box
+ frames.
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the BlackBox.c
+ file.
+==============================================================================*/
+
+// Black box enable definition
+//#define BLACKBOX
+
+// Black box definitions
+#define BLACKBOX_RECORDS 24         // Records kept (5 bytes each)
+#define BLACKBOX_PERIOD 8           // Ticks between records (5.5 ms)
+#define BLACKBOX_MAGIC  0xB10C      // Header magic number
+#define BLACKBOX_KEY    0x5A        // Check byte key
+#define BLACKBOX_ID     0x20        // Dump statistics frame ID (see Telemetry.h)
+
+// Black box record type
+typedef struct
+{
+    unsigned char sensorL;          // Left sensor level
+    unsigned char sensorR;          // Right sensor level
+    unsigned char motorL;           // Left motor command
+    unsigned char motorR;           // Right motor command
+    unsigned char status;           // Mode (bit 7), loop period / 4 (bits 0-6)
+} blackbox_t;
+
+#ifdef BLACKBOX
+
+extern unsigned char blackbox_cause;    // PCON reset flags at boot
+
+// Prototypes for BlackBox.c functions:
+
+/**
+ * Function: bool blackbox_boot(void)
+ *
+ * Record and re-arm the reset cause flags, and check the black box header.
+ * Returns true if the black box holds a recording from before the reset. Call
+ * once at the start of the main program.
+ */
+bool blackbox_boot(void);
+
+/**
+ * Function: void blackbox_start(void)
+ *
+ * Clear the black box and start a new recording.
+ */
+void blackbox_start(void);
+
+/**
+ * Function: void blackbox_record(unsigned char mode, unsigned char sensorL,
+ *                                unsigned char sensorR, unsigned char motorL,
+ *                                unsigned char motorR, unsigned int period)
+ *
+ * Add a record to the black box, replacing the oldest record once it is full.
+ * The arguments are the same as those of telemetry_frame().
+ *
+ * Example usage: blackbox_record(mode, lightLevelLeft, lightLevelRight,
+ *                                leftSpeed / 2, rightSpeed / 2, loopPeriod);
+ */
+void blackbox_record(unsigned char, unsigned char, unsigned char,
+                     unsigned char, unsigned char, unsigned int);
+
+/**
+ * Function: unsigned char blackbox_count(void)
+ *
+ * Return the number of records in the black box.
+ */
+unsigned char blackbox_count(void);
+
+/**
+ * Function: void blackbox_read(unsigned char index, blackbox_t *record)
+ *
+ * Copy a record from the black box, where index 0 is the oldest record and
+ * blackbox_count() - 1 is the newest.
+ *
+ * Example usage: blackbox_read(i, &record);
+ */
+void blackbox_read(unsigned char, blackbox_t *);
+
+#endif
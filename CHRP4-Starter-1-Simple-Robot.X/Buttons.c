@@ -0,0 +1,115 @@
+/*==============================================================================
+ File: Buttons.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) debounced pushbutton functions
+
+ Interrupt-sampled, bit-parallel (vertical counter) pushbutton debouncing with
+ press, release, and long press events. Include the Buttons.h file in your
+ main program to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "Scheduler.h"       // Include scheduler tick counter
+#include    "Buttons.h"         // Include pushbutton constant & function definitions
+
+volatile unsigned char button_state;    // Debounced states (1 = pressed)
+unsigned char button_enabled = BUTTONS_ALL; // Sampled switch bits
+unsigned char button_count0 = 0xFF;     // Vertical counter bit 0 (per switch)
+unsigned char button_count1 = 0xFF;     // Vertical counter bit 1 (per switch)
+unsigned char button_sampled;           // Tick of the last sample
+unsigned char button_held;              // Samples with a stable held state
+unsigned char button_queue[BUTTON_QUEUE];   // Event queue
+volatile unsigned char button_head;     // Next queue index to write
+volatile unsigned char button_tail;     // Next queue index to read
+
+// Select the sampled switches and clear the debounce state and event queue.
+void buttons_mask(unsigned char mask)
+{
+    unsigned char gie = GIE;
+
+    GIE = 0;
+    button_enabled = mask;
+    button_state = 0;
+    button_count0 = 0xFF;
+    button_count1 = 0xFF;
+    button_held = 0;
+    button_head = button_tail;
+    GIE = gie;
+}
+
+// Queue one event for each switch bit set in 'changed'. Events are dropped if
+// the queue is full.
+void buttons_queue(unsigned char changed, unsigned char type)
+{
+    unsigned char next;
+
+    for(unsigned char n = 1; n != 6; n ++)
+    {
+        if(changed & BUTTON_BIT(n))
+        {
+            next = (button_head + 1) & (BUTTON_QUEUE - 1);
+            if(next != button_tail)
+            {
+                button_queue[button_head] = type | n;
+                button_head = next;
+            }
+        }
+    }
+}
+
+// Sample and debounce all switches. Each switch's vertical counter is reset
+// while its input matches its debounced state, and counts down while it does
+// not. When a counter rolls over, the switch's debounced state toggles.
+void buttons_isr(void)
+{
+    unsigned char changed;
+
+    // Sample every BUTTON_DIVIDER ticks (on average, if ticks are counted in
+    // steps of more than one at slow clock profiles)
+    if((unsigned char)(sched_ticks - button_sampled) < BUTTON_DIVIDER)
+    {
+        return;
+    }
+    button_sampled += BUTTON_DIVIDER;
+
+    // Inputs read 0 when pressed, so invert them to make pressed = 1
+    changed = button_state ^ (~((PORTB & 0b11110000) | (PORTA & 0b00001000))
+                              & button_enabled);
+    button_count0 = ~(button_count0 & changed);
+    button_count1 = button_count0 ^ (button_count1 & changed);
+    changed &= button_count0 & button_count1;
+    button_state ^= changed;
+
+    if(changed != 0)
+    {
+        buttons_queue(button_state & changed, BUTTON_PRESSED);
+        buttons_queue(~button_state & changed, BUTTON_RELEASED);
+        button_held = 0;
+    }
+    else if(button_state != 0 && button_held != BUTTON_LONG_TIME)
+    {
+        button_held ++;
+        if(button_held == BUTTON_LONG_TIME)
+        {
+            buttons_queue(button_state, BUTTON_LONG);
+        }
+    }
+}
+
+// Return the oldest queued event, or BUTTON_NONE.
+unsigned char button_event(void)
+{
+    unsigned char event;
+
+    if(button_tail == button_head)
+    {
+        return (BUTTON_NONE);
+    }
+    event = button_queue[button_tail];
+    button_tail = (button_tail + 1) & (BUTTON_QUEUE - 1);
+    return (event);
+}
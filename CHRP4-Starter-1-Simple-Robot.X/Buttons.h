@@ -0,0 +1,74 @@
+/*==============================================================================
+ File: Buttons.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) debounced pushbutton constant and function definitions.
+
+ Pushbutton sampling and debouncing:
+ Pushbuttons SW1 (RA3) and SW2-SW5 (RB4-RB7) are sampled together as one byte
+ every BUTTON_DIVIDER scheduler ticks (5.46 ms) from the Timer0 interrupt, and
+ debounced all at once using a two-bit vertical counter: each bit position of
+ the two counter bytes forms a separate counter for one switch, which must
+ read the same new level for four samples in a row (22 ms) before its
+ debounced state changes. Debouncing takes the same few instructions on every
+ sample, no matter how many switches are bouncing.
+
+ Pushbutton events:
+ Each debounced press or release of a switch, and each switch that is held for
+ BUTTON_LONG_TIME samples (about 1 s), adds an event to a small queue that the
+ main program reads with button_event(). An event is a type (BUTTON_PRESSED,
+ BUTTON_RELEASED, or BUTTON_LONG) ORed with the switch number (1-5), e.g.
+ (BUTTON_PRESSED | 3) is a press of SW3. SW2-SW5 share their pins with the H1-
+ H4 headers, so switches whose pins are used for other purposes can be left
+ out of sampling with buttons_mask().
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the Buttons.c
+ file.
+==============================================================================*/
+
+// Pushbutton definitions
+#define BUTTON_DIVIDER  8           // Scheduler ticks per sample (5.46 ms)
+#define BUTTON_LONG_TIME 183        // Samples for a long press (about 1 s)
+#define BUTTON_QUEUE    8           // Event queue size (power of 2)
+#define BUTTONS_ALL     0b11111000  // Sample bits of SW1 (bit 3) and SW2-SW5
+#define BUTTON_BIT(n)   (1 << ((n) + 2))    // Sample bit of switch SWn
+
+// Pushbutton event definitions
+#define BUTTON_NONE     0x00        // No event
+#define BUTTON_PRESSED  0x40        // Switch pressed (add switch number)
+#define BUTTON_RELEASED 0x80        // Switch released (add switch number)
+#define BUTTON_LONG     0xC0        // Switch held down (add switch number)
+
+// Debounced switch states (1 = pressed, using the sample bits above)
+extern volatile unsigned char button_state;
+
+// Prototypes for Buttons.c functions:
+
+/**
+ * Function: void buttons_mask(unsigned char mask)
+ *
+ * Set which switches are sampled, using the sample bits of the switches (see
+ * BUTTONS_ALL and BUTTON_BIT), and clear the debounce state and event queue.
+ *
+ * Example usage: buttons_mask(BUTTONS_ALL & ~BUTTON_BIT(5));
+ */
+void buttons_mask(unsigned char);
+
+/**
+ * Function: void buttons_isr(void)
+ *
+ * Pushbutton sampling handler, called on each Timer0 tick. Samples and
+ * debounces the switches every BUTTON_DIVIDER ticks and queues any events.
+ */
+void buttons_isr(void);
+
+/**
+ * Function: unsigned char button_event(void)
+ *
+ * Return the oldest queued pushbutton event, or BUTTON_NONE if there are no
+ * events waiting.
+ *
+ * Example usage: if(button_event() == (BUTTON_PRESSED | 1))
+ */
+unsigned char button_event(void);
@@ -6,8 +6,9 @@
  
  Initialization functions used to configure the PIC16F1459 oscillator, on-board
  CHRP4 I/O devices, and ADC (analog-to-digital converter), as well as ADC
- channel selection and conversion functions. Include the CHRP4.h file in your
- main program to call these functions. Add or modify functions as needed.
+ channel selection and conversion functions, and an interrupt-driven ADC scan
+ engine. Include the CHRP4.h file in your main program to call these
+ functions. Add or modify functions as needed.
 ==============================================================================*/
 
 #include    "xc.h"              // Microchip XC8 compiler include file
@@ -16,12 +17,54 @@
 
 #include    "CHRP4.h"           // Include CHRP4 constant & function definitions
 
+// ADC background scan channel list and sample set ring buffer
+#if defined(SENSOR_ARRAY) && defined(SENSOR_MUX)
+const unsigned char ADC_scan_channels[ADC_SCAN_COUNT] = {
+    ANQ1, ANQ2, ANH1, ANH2, ANH1, ANH2
+};
+const unsigned char ADC_scan_mux[ADC_SCAN_COUNT] = {0, 0, 0, 0, 1, 1};
+#elif defined(SENSOR_ARRAY)
+const unsigned char ADC_scan_channels[ADC_SCAN_COUNT] = {ANQ1, ANQ2, ANH1, ANH2};
+#else
+const unsigned char ADC_scan_channels[ADC_SCAN_COUNT] = {ANQ1, ANQ2};
+#endif
+volatile unsigned char ADC_ring[ADC_SCAN_SETS][ADC_SCAN_COUNT];
+volatile unsigned char ADC_ring_head;   // Ring index of newest complete set
+volatile unsigned char ADC_sets;        // Completed sample set counter
+unsigned char ADC_scan_index;           // Scan list index being converted
+unsigned char ADC_scan_set;             // Ring index of set being filled
+unsigned int ADC_work[ADC_SCAN_COUNT];  // 10-bit sample set being converted
+volatile unsigned int ADC_fvr;          // Newest 10-bit FVR result (0 = none)
+unsigned char ADC_fvr_rounds;           // Scans since the last FVR conversion
+
+// ADC high-resolution (oversampled) sample sets
+volatile unsigned int ADC_hires[ADC_SCAN_COUNT];    // Newest 12-bit set
+volatile unsigned char ADC_hires_sets;  // Completed 12-bit set counter
+unsigned int ADC_hires_sum[ADC_SCAN_COUNT]; // Sums of 10-bit sets so far
+unsigned char ADC_hires_count;          // Sets summed so far
+
+// ADC synchronous sensing state
+unsigned char ADC_sync_pairs;           // LED off/on pairs per result (0 = off)
+unsigned char ADC_sync_shift;           // log2(ADC_sync_pairs) for averaging
+unsigned char ADC_sync_count;           // Pairs summed so far
+bool ADC_sync_dark;                     // true while LEDs are off
+unsigned int ADC_sync_lit[ADC_SCAN_COUNT];  // LED-on levels of current pair
+unsigned int ADC_sync_sum[ADC_SCAN_COUNT];  // Sum of reflected light levels
+
+// ADC moving average and IIR filter states
+unsigned int ADC_average_history[ADC_FILTERS][ADC_AVERAGE];
+unsigned int ADC_average_sum[ADC_FILTERS];
+unsigned char ADC_average_pos[ADC_FILTERS];
+unsigned int ADC_iir_sum[ADC_FILTERS];
+
 // Configure oscillator for 48 MHz operation (required for USB-uC bootloader).
 void OSC_config(void)
 {
     OSCCON = 0xFC;              // Set 16MHz HFINTOSC with 3x PLL enabled
     ACTCON = 0x90;              // Enable active clock tuning from USB clock
-    while(!PLLRDY);             // Wait for PLL lock (disable for simulation)
+#ifndef SIMULATION
+    while(!PLLRDY);             // Wait for PLL lock (skipped for simulation)
+#endif
 }
 
 // Configure hardware ports and peripherals for on-board CHRP4 I/O devices.
@@ -44,7 +87,18 @@ void CHRP4_config(void)
     ANSELC = 0b00000000;        // Disable analog input on all PORTC input pins
     TRISC = 0b00001100;         // Enable phototransistor Q1/Q3, Q2/Q4 inputs
 
-    // TODO - Enable interrupts here, if required.
+    PEIE = 1;                   // Enable peripheral interrupts
+    GIE = 1;                    // Enable global interrupts (see isr() in main)
+}
+
+// Configure Timer1 as a free-running instruction cycle counter (FOSC/4, 1:1).
+void TMR1_config(void)
+{
+    T1CON = 0b00000000;         // Stop Timer1, FOSC/4 clock, 1:1 prescaler
+    T1GCON = 0b00000000;        // Timer1 gate disabled (always counting)
+    TMR1H = 0;
+    TMR1L = 0;
+    TMR1ON = 1;                 // Start Timer1
 }
 
 // Configure ADC for 8-bit conversion. Set on-board phototransistor Q1 as input.
@@ -56,6 +110,13 @@ void ADC_config(void)
     TRISCbits.TRISC2 = 1;       // Disable Q1/Q3 output driver (TRISx.bit = 1)
     TRISCbits.TRISC3 = 1;       // Disable Q2/Q4 output driver
     ANSELC = 0b00001100;        // Enable Q1 & Q2 analog input (ANSELx.bit = 1)
+#ifdef SENSOR_ARRAY
+    WPUB = WPUB & ~0b00110000;  // No pull-ups on the H1 & H2 array sensors
+    ANSELB = 0b00110000;        // Enable H1 & H2 analog input
+#ifdef SENSOR_MUX
+    TRISBbits.TRISB6 = 0;       // Enable H3 multiplexer select output
+#endif
+#endif
     
     // General ADC setup and configuration
     ADCON0 = 0b00011100;        // Set channel to Q1/AN7, leave ADC off
@@ -95,3 +156,287 @@ unsigned char ADC_read_channel(unsigned char channel)
     ADON = 0;                   // Turn the ADC off
     return (ADRESH);            // Return the MSB (upper 8-bits) of the result
 }
+
+// Clear all filter channel states.
+void ADC_filter_reset(void)
+{
+    for(unsigned char f = 0; f != ADC_FILTERS; f ++)
+    {
+        for(unsigned char i = 0; i != ADC_AVERAGE; i ++)
+        {
+            ADC_average_history[f][i] = 0;
+        }
+        ADC_average_sum[f] = 0;
+        ADC_average_pos[f] = 0;
+        ADC_iir_sum[f] = 0;
+    }
+}
+
+// Moving average filter - replace the oldest sample in the running sum with
+// the new sample, and return the sum divided by the window size.
+unsigned int ADC_filter_average(unsigned char filter, unsigned int sample)
+{
+    unsigned char pos = ADC_average_pos[filter];
+    
+    ADC_average_sum[filter] += sample - ADC_average_history[filter][pos];
+    ADC_average_history[filter][pos] = sample;
+    ADC_average_pos[filter] = (pos + 1) & (ADC_AVERAGE - 1);
+    return (ADC_average_sum[filter] >> ADC_AVERAGE_SHIFT);
+}
+
+// IIR filter - the sum holds the output scaled by 2^shift, and moves towards
+// each new sample by 1/2^shift of the difference.
+unsigned int ADC_filter_iir(unsigned char filter, unsigned int sample, unsigned char shift)
+{
+    ADC_iir_sum[filter] += sample - (ADC_iir_sum[filter] >> shift);
+    return (ADC_iir_sum[filter] >> shift);
+}
+
+// Clear the high-resolution sums so the next 12-bit set starts afresh.
+void ADC_hires_reset(void)
+{
+    ADC_hires_count = 0;
+    for(unsigned char i = 0; i != ADC_SCAN_COUNT; i ++)
+    {
+        ADC_hires_sum[i] = 0;
+    }
+}
+
+// Start background conversions of the scan list channels. Each Timer2 period
+// match triggers one conversion (2.94 kHz with the motor PWM settings), so a
+// full sample set is published every ADC_SCAN_COUNT x 340 us with no main loop
+// overhead.
+void ADC_scan_start(void)
+{
+    ADC_config();               // Configure analog inputs and ADC clock
+    ADIE = 0;
+    ADFM = 1;                   // Right justify the full 10-bit results
+    ADC_scan_index = 0;
+    ADC_scan_set = 0;
+    ADC_sync_pairs = 0;         // Start with raw (not synchronous) sampling
+    ADC_fvr = 0;
+    ADC_fvr_rounds = 0;
+    ADC_hires_sets = 0;
+    ADC_hires_reset();
+    FVRCON = (FVRCON & 0b00110000) | ADC_FVR_ON;    // Supply measurement reference
+#ifdef SENSOR_MUX
+    H3OUT = ADC_scan_mux[0];
+#endif
+    ADCON0 = ADC_scan_channels[0] | 0b00000001; // Select first channel, ADC on
+    ADIF = 0;
+    ADIE = 1;                   // Enable ADC conversion complete interrupt
+    ADCON2 = ADC_TRIG_TMR2;     // Start conversions from Timer2 period match
+}
+
+// Switch the scan engine to synchronous sensing averaged over 1, 2, 4, or 8
+// LED off/on pairs, or back to raw sampling (pairs = 0). The scan restarts at
+// the first channel with the LEDs on.
+void ADC_scan_sync(unsigned char pairs)
+{
+    ADIE = 0;
+    ADC_sync_pairs = pairs;
+    ADC_sync_shift = 0;
+    while(pairs > 1)
+    {
+        ADC_sync_shift ++;
+        pairs >>= 1;
+    }
+    ADC_sync_count = 0;
+    ADC_sync_dark = false;
+    for(unsigned char i = 0; i != ADC_SCAN_COUNT; i ++)
+    {
+        ADC_sync_sum[i] = 0;
+    }
+    ADC_hires_reset();          // Do not mix raw and synchronous sets
+    D6 = 1;                     // Floor sensor LEDs on
+    D8 = 1;
+    ADC_scan_index = 0;
+#ifdef SENSOR_MUX
+    H3OUT = ADC_scan_mux[0];
+#endif
+    ADCON0 = ADC_scan_channels[0] | 0b00000001; // Select first channel, ADC on
+    ADIF = 0;
+    ADIE = 1;
+}
+
+// Stop background conversions and return Q1/Q2 (and H1/H2) to digital inputs.
+void ADC_scan_stop(void)
+{
+    ADCON2 = 0b00000000;        // Auto-conversion trigger disabled
+    ADIE = 0;
+    ADON = 0;                   // Turn the ADC off
+    ADFM = 0;                   // Restore left justified 8-bit results
+    FVRCON = FVRCON & 0b00110000;   // Turn the FVR off
+    ANSELC = 0b00000000;        // Disable analog input on all PORTC input pins
+#ifdef SENSOR_ARRAY
+    ANSELB = 0b00000000;        // Disable analog input on all PORTB input pins
+    WPUB = WPUB | 0b00110000;   // Restore the SW2 & SW3 pull-ups
+#endif
+}
+
+// Publish the upper 8 bits of the completed work sample set in the ring
+// buffer, and add the full 10-bit samples to the high-resolution sums. Every
+// ADC_OVERSAMPLE sets, the 14-bit sums are decimated to a 12-bit set.
+void ADC_publish(void)
+{
+    for(unsigned char i = 0; i != ADC_SCAN_COUNT; i ++)
+    {
+        ADC_ring[ADC_scan_set][i] = (unsigned char)(ADC_work[i] >> 2);
+        ADC_hires_sum[i] += ADC_work[i];
+    }
+    ADC_ring_head = ADC_scan_set;
+    ADC_scan_set = (ADC_scan_set + 1) & (ADC_SCAN_SETS - 1);
+    ADC_sets ++;
+    
+    ADC_hires_count ++;
+    if(ADC_hires_count == ADC_OVERSAMPLE)
+    {
+        ADC_hires_count = 0;
+        for(unsigned char i = 0; i != ADC_SCAN_COUNT; i ++)
+        {
+            ADC_hires[i] = ADC_hires_sum[i] >> ADC_HIRES_SHIFT;
+            ADC_hires_sum[i] = 0;
+        }
+        ADC_hires_sets ++;
+    }
+}
+
+// Handle a completed sample set in synchronous sensing mode. LED-on sets are
+// saved, and each following LED-off set adds the reflected light (dark level
+// minus lit level) to the sums. The LEDs are toggled for the next set.
+void ADC_sync_set(void)
+{
+    unsigned int reflected;
+    
+    if(!ADC_sync_dark)
+    {
+        for(unsigned char i = 0; i != ADC_SCAN_COUNT; i ++)
+        {
+            ADC_sync_lit[i] = ADC_work[i];
+        }
+        D6 = 0;                 // Floor sensor LEDs off for the next set
+        D8 = 0;
+        ADC_sync_dark = true;
+        return;
+    }
+    
+    for(unsigned char i = 0; i != ADC_SCAN_COUNT; i ++)
+    {
+        reflected = 0;
+        if(ADC_work[i] > ADC_sync_lit[i])
+        {
+            reflected = ADC_work[i] - ADC_sync_lit[i];
+        }
+        ADC_sync_sum[i] += reflected;
+    }
+    D6 = 1;                     // Floor sensor LEDs on for the next set
+    D8 = 1;
+    ADC_sync_dark = false;
+    
+    ADC_sync_count ++;
+    if(ADC_sync_count == ADC_sync_pairs)
+    {
+        ADC_sync_count = 0;     // Publish average darkness of the pairs
+        for(unsigned char i = 0; i != ADC_SCAN_COUNT; i ++)
+        {
+            ADC_work[i] = 1023 - (ADC_sync_sum[i] >> ADC_sync_shift);
+            ADC_sync_sum[i] = 0;
+        }
+        ADC_publish();
+    }
+}
+
+// ADC interrupt handler - store the result and move on to the next channel.
+// After every 256th scan, the FVR is converted in an extra scan list slot.
+void ADC_scan_isr(void)
+{
+    ADIF = 0;
+    if(ADC_scan_index == ADC_SCAN_COUNT)
+    {
+        ADC_fvr = ((unsigned int)ADRESH << 8) | ADRESL;
+        ADC_scan_index = 0;
+    }
+    else
+    {
+        ADC_work[ADC_scan_index] = ((unsigned int)ADRESH << 8) | ADRESL;
+        ADC_scan_index ++;
+        if(ADC_scan_index == ADC_SCAN_COUNT)
+        {
+            if(ADC_sync_pairs == 0) // Sample set complete
+            {
+                ADC_publish();
+            }
+            else
+            {
+                ADC_sync_set();
+            }
+            ADC_fvr_rounds ++;
+            if(ADC_fvr_rounds != 0)
+            {
+                ADC_scan_index = 0; // Otherwise, convert the FVR next
+            }
+        }
+    }
+    // Select the next channel now so it settles before the next trigger
+    if(ADC_scan_index == ADC_SCAN_COUNT)
+    {
+        ADCON0 = ANFVR | 0b00000001;
+    }
+    else
+    {
+#ifdef SENSOR_MUX
+        H3OUT = ADC_scan_mux[ADC_scan_index];
+#endif
+        ADCON0 = ADC_scan_channels[ADC_scan_index] | 0b00000001;
+    }
+}
+
+// Return the newest FVR result, reading it again if the ISR changed it while
+// its two bytes were being read.
+unsigned int ADC_scan_fvr(void)
+{
+    unsigned int fvr;
+    
+    do
+    {
+        fvr = ADC_fvr;
+    } while(fvr != ADC_fvr);
+    return (fvr);
+}
+
+// Copy the newest complete sample set without blocking. The set counter is
+// checked before and after the copy, and the copy is repeated in the unlikely
+// case that the ISR published a new set (and wrapped the ring) in between.
+unsigned char ADC_scan_read(unsigned char *samples)
+{
+    unsigned char sets;
+    unsigned char set;
+    
+    do
+    {
+        sets = ADC_sets;
+        set = ADC_ring_head;
+        for(unsigned char i = 0; i != ADC_SCAN_COUNT; i ++)
+        {
+            samples[i] = ADC_ring[set][i];
+        }
+    } while(sets != ADC_sets);
+    return (sets);
+}
+
+// Copy the newest complete 12-bit sample set without blocking, in the same way
+// as ADC_scan_read().
+unsigned char ADC_scan_hires(unsigned int *samples)
+{
+    unsigned char sets;
+    
+    do
+    {
+        sets = ADC_hires_sets;
+        for(unsigned char i = 0; i != ADC_SCAN_COUNT; i ++)
+        {
+            samples[i] = ADC_hires[i];
+        }
+    } while(sets != ADC_hires_sets);
+    return (sets);
+}
@@ -19,6 +19,68 @@
  are used to switch between ADC channels available on CHRP4. These definitions
  are used with the ADC_select_channel and ADC_read_channel functions.
  
+ ADC background scan definitions section:
+ Settings for the interrupt-driven ADC scan engine, which converts each channel
+ in its scan list once per Timer2 (motor PWM) period and stores complete sets
+ of samples in a small ring buffer that the main program can read at any time.
+ Each Timer2 period match starts one conversion, and the ADC interrupt selects
+ the next channel straight away, so every channel settles for a full 340 us
+ Timer2 period before it is converted and the interrupt never has to wait. A
+ set takes ADC_SCAN_COUNT x 340 us, so the time taken by a set grows linearly
+ with the number of channels: a new set is published every 680 us (once per
+ scheduler tick) for Q1 and Q2, every 1.36 ms for four sensors, and every
+ 2.04 ms for six.
+
+ The scan list holds Q1 and Q2. Define SENSOR_ARRAY to add line sensors on the
+ H1 and H2 header pins (AN10 and AN11) to the scan list for the sensor array
+ (see SensorArray.h), and also define SENSOR_MUX to scan two inputs of an
+ external analog multiplexer on each of H1 and H2, selected by H3. The scan
+ list always starts with Q1 and Q2, so SCAN_Q1 and SCAN_Q2 are the same in
+ every configuration.
+ 
+ In synchronous sensing mode, the scan engine turns the floor sensor LEDs
+ (D6-D8) off and on between alternate sample sets, and publishes the light
+ level difference between each LED-off and LED-on pair instead of the raw
+ levels. Ambient light affects both sets of each pair equally, so it cancels
+ out, leaving only the light reflected from the LEDs. Results are published as
+ darkness levels (255 minus the reflected light difference) to match raw ADC
+ levels (darker = higher value), and are averaged over 1, 2, 4, or 8 pairs.
+ Each published set then takes 2 x pairs x ADC_SCAN_COUNT x 340 us (735 Hz
+ for a single pair of Q1/Q2 sets). The LEDs are switched in the ADC interrupt,
+ a full Timer2 period before the next conversion starts, so the
+ phototransistors settle for 340 us after each change. The extra interrupt
+ work is about 100 instruction cycles per pair, which is less than 1% of the
+ CPU time.
+ 
+ The scan engine also measures the supply voltage. After every 256th scan of
+ the list (174 ms with Q1 and Q2) it converts the 1.024 V Fixed Voltage
+ Reference (ANFVR) once, using VDD as the ADC reference, which delays the next
+ scan by one Timer2 period. The 10-bit result is 1.024 V x 1023 / VDD, so it is
+ inversely proportional to the supply voltage (about 210 at 5.0 V and 250 at
+ 4.2 V), and is read with ADC_scan_fvr().
+ 
+ ADC oversampling and filter definitions section:
+ The scan engine right-justifies its conversions, so each sample starts as a
+ full 10-bit result, and ADC_scan_read() returns its upper 8 bits. The scan
+ engine also sums each channel's 10-bit samples over ADC_OVERSAMPLE (16)
+ published sample sets and decimates the 14-bit sums to 12-bit results
+ (0-4095), which ADC_scan_hires() reads as a higher resolution alternative to
+ ADC_scan_read(). The two extra bits are real as long as there is at least 1
+ LSB of noise on the input, which is always the case with the phototransistor
+ circuits. Synchronous sensing sets are summed in the same way, as 10-bit
+ darkness levels (1023 minus the reflected light difference). A 12-bit set
+ takes 16 sample sets, or 10.9 ms for raw Q1/Q2 sets and 21.8 ms for single
+ pair synchronous sets, so it suits calibration better than the control loop.
+ The extra interrupt work is about 25 instruction cycles per channel for each
+ sample set, plus about 30 per channel for each 12-bit set, which is less than
+ 1% of the CPU time.
+ 
+ The ADC filter functions smooth a stream of samples in O(1) time per sample,
+ using a separate filter state for each of ADC_FILTERS channels: a running-sum
+ moving average of the last ADC_AVERAGE samples, or a first-order IIR
+ (exponential) filter with a 2^shift sample time constant. Inputs can be up to
+ 12 bits wide for IIR shifts of up to 4.
+ 
  Function prototypes section:
  Function prototype definitions for each of the functions in the CHRP4.c file
  are located here. Function prototypes must exist for all external functions
@@ -99,9 +161,45 @@
 #define AN11        0b00101100      // A-D converter channel 11 input (H2)
 #define ANH2        0b00101100      // A-D converter channel 11 input (H2)
 #define ANTIM       0b01110100      // On-die temperature indicator module input
+#define ANFVR       0b01111100      // Fixed Voltage Reference (FVR) buffer 1 input
+
+// ADC background scan definitions
+//#define SENSOR_ARRAY                // Scan H1 & H2 line sensors (SensorArray.h)
+//#define SENSOR_MUX                  // Scan H1 & H2 multiplexers (H3 selects)
+#if defined(SENSOR_ARRAY) && defined(SENSOR_MUX)
+#define ADC_SCAN_COUNT  6           // Q1, Q2, H1 & H2 multiplexer inputs 0 & 1
+#define ADC_SCAN_PINS   0b01110000  // H1-H3 (RB4-RB6) pins used by the scan
+#elif defined(SENSOR_ARRAY)
+#define ADC_SCAN_COUNT  4           // Q1, Q2, H1, H2
+#define ADC_SCAN_PINS   0b00110000  // H1-H2 (RB4-RB5) pins used by the scan
+#else
+#define ADC_SCAN_COUNT  2           // Number of channels in the scan list
+#define ADC_SCAN_PINS   0b00000000  // No header pins used by the scan
+#endif
+#define ADC_SCAN_SETS   4           // Sample sets in ring buffer (power of 2)
+#define ADC_TRIG_TMR2   0b01010000  // ADCON2 auto-conversion trigger: TMR2=PR2
+#define SCAN_Q1     0               // Q1 sample index in a scanned sample set
+#define SCAN_Q2     1               // Q2 sample index in a scanned sample set
+#define ADC_SYNC_MAX    8           // Maximum synchronous sensing pairs averaged
+#define ADC_FVR_ON      0b10000001  // FVRCON: FVR on, 1.024 V ADC output
+#define ADC_FVR_MV      1024        // FVR ADC output voltage (mV)
+
+// ADC oversampling and filter definitions
+#define ADC_OVERSAMPLE  16          // Sample sets summed per 12-bit set
+#define ADC_HIRES_SHIFT 2           // Decimate 14-bit sums to 12 bits
+#define ADC_FILTERS     2           // Number of filter channels
+#define ADC_AVERAGE     8           // Moving average window (power of 2)
+#define ADC_AVERAGE_SHIFT 3         // log2(ADC_AVERAGE)
 
 // Clock frequency definition for delay macros and simulation
 #define _XTAL_FREQ  48000000        // Set clock frequency for time delays
+                                    // (POWER_48MHZ profile, see Power.h)
+
+// Define SIMULATION (e.g. in the project's XC8 compiler 'Define macros' setting)
+// to build code that runs in the MPLAB X simulator without waiting on hardware
+// status bits that never change there. The host simulator in tools/sim models
+// these bits, so it builds the firmware without SIMULATION.
+//#define SIMULATION
 
 // Prototypes for CHRP4.c functions:
 
@@ -119,6 +217,14 @@ void OSC_config(void);
  */
 void CHRP4_config(void);
 
+/**
+ * Function: void TMR1_config(void)
+ * 
+ * Configure Timer1 as a free-running 16-bit instruction cycle counter, clocked
+ * by FOSC/4 (12 MHz) with a 1:1 prescaler. TMR1 overflows every 5.46 ms.
+ */
+void TMR1_config(void);
+
 /**
  * Function: void ADC_config(void)
  * 
@@ -155,5 +261,109 @@ unsigned char ADC_read(void);
  */
 unsigned char ADC_read_channel(unsigned char);
 
+/**
+ * Function: void ADC_scan_start(void)
+ * 
+ * Configure the ADC and start background conversions of every channel in the
+ * scan list. Conversions are triggered by Timer2 (configured by motor_config)
+ * and collected by ADC_scan_isr, so the ADC stays powered and no time is spent
+ * settling inputs or waiting for conversions in the main program loop. With
+ * SENSOR_ARRAY, H1 and H2 (SW2 and SW3) become analog inputs.
+ */
+void ADC_scan_start(void);
+
+/**
+ * Function: void ADC_scan_sync(unsigned char pairs)
+ * 
+ * Switch the running ADC scan engine to synchronous (ambient light rejecting)
+ * sensing, averaging the specified number of LED off/on sample set pairs (1,
+ * 2, 4 or 8) for each published sample set. A pairs value of 0 returns the
+ * scan engine to raw sampling with the LEDs left on.
+ * 
+ * Example usage: ADC_scan_sync(2);
+ */
+void ADC_scan_sync(unsigned char);
+
+/**
+ * Function: void ADC_scan_stop(void)
+ * 
+ * Stop background ADC conversions, turn the ADC off, and return the Q1/Q2
+ * sensor pins (and any H1/H2 array pins) to digital inputs.
+ */
+void ADC_scan_stop(void);
+
+/**
+ * Function: void ADC_scan_isr(void)
+ * 
+ * ADC interrupt handler. Stores the finished conversion result, publishes the
+ * sample set once every channel in the scan list has been converted, and
+ * selects the next channel so that it can settle until the next trigger.
+ */
+void ADC_scan_isr(void);
+
+/**
+ * Function: unsigned char ADC_scan_read(unsigned char *samples)
+ * 
+ * Copy the newest complete sample set (ADC_SCAN_COUNT 8-bit results, in scan
+ * list order) into the samples array without blocking. Returns the number of
+ * sample sets completed so far so that callers can tell when new data arrives.
+ * 
+ * Example usage: ADC_scan_read(lightLevels);
+ */
+unsigned char ADC_scan_read(unsigned char *);
+
+/**
+ * Function: unsigned char ADC_scan_hires(unsigned int *samples)
+ * 
+ * Copy the newest complete high-resolution sample set (ADC_SCAN_COUNT 12-bit
+ * results, in scan list order) into the samples array without blocking.
+ * Returns the number of 12-bit sets completed since the scan was started, so
+ * 0 means that there is no set yet.
+ * 
+ * Example usage: ADC_scan_hires(levels);
+ */
+unsigned char ADC_scan_hires(unsigned int *);
+
+/**
+ * Function: unsigned int ADC_scan_fvr(void)
+ * 
+ * Return the newest 10-bit FVR conversion made by the ADC scan engine, or 0 if
+ * there has not been one since the scan was started.
+ * 
+ * Example usage: motor_supply(ADC_scan_fvr());
+ */
+unsigned int ADC_scan_fvr(void);
+
+/**
+ * Function: void ADC_filter_reset(void)
+ * 
+ * Clear the state of all moving average and IIR filter channels.
+ */
+void ADC_filter_reset(void);
+
+/**
+ * Function: unsigned int ADC_filter_average(unsigned char filter,
+ *                                           unsigned int sample)
+ * 
+ * Add a sample to the moving average filter channel and return the average of
+ * its last ADC_AVERAGE samples.
+ * 
+ * Example usage: level = ADC_filter_average(SCAN_Q1, levels[SCAN_Q1]);
+ */
+unsigned int ADC_filter_average(unsigned char, unsigned int);
+
+/**
+ * Function: unsigned int ADC_filter_iir(unsigned char filter,
+ *                                       unsigned int sample,
+ *                                       unsigned char shift)
+ * 
+ * Add a sample to the IIR filter channel and return the filtered value. Each
+ * sample moves the output 1/2^shift of the way towards the new sample, and a
+ * shift of 0 returns each sample unfiltered.
+ * 
+ * Example usage: level = ADC_filter_iir(SCAN_Q1, lightLevel, 2);
+ */
+unsigned int ADC_filter_iir(unsigned char, unsigned int, unsigned char);
+
 // TODO - Add additional function prototypes for any new functions added to
 // the CHRP4.c file here.
@@ -0,0 +1,112 @@
+/*==============================================================================
+ File: Calibration.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) light sensor calibration functions
+
+ Functions to record the light level range of each line sensor and to build
+ lookup tables that normalize raw sensor readings to a common 0-255 darkness
+ range. Include the Calibration.h file in your main program to call these
+ functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "CHRP4.h"           // Include CHRP4 constant & function definitions
+#include    "Calibration.h"     // Include calibration constant & function definitions
+
+unsigned char cal_min[CAL_SENSORS];         // Lightest raw level seen
+unsigned char cal_max[CAL_SENSORS];         // Darkest raw level seen
+unsigned char cal_lut[CAL_TABLES][256];     // Normalization tables
+
+// Clear the recorded light level ranges.
+void cal_reset(void)
+{
+    for(unsigned char s = 0; s != CAL_SENSORS; s ++)
+    {
+        cal_min[s] = 255;
+        cal_max[s] = 0;
+    }
+}
+
+// Widen each sensor's recorded light level range to include the new levels.
+void cal_sample(unsigned char *levels)
+{
+    for(unsigned char s = 0; s != CAL_SENSORS; s ++)
+    {
+        if(levels[s] < cal_min[s])
+        {
+            cal_min[s] = levels[s];
+        }
+        if(levels[s] > cal_max[s])
+        {
+            cal_max[s] = levels[s];
+        }
+    }
+}
+
+// Return the integer square root of a 16-bit value (bit-by-bit method).
+unsigned char cal_sqrt(unsigned int value)
+{
+    unsigned char root = 0;
+
+    for(unsigned char bit = 0x80; bit != 0; bit >>= 1)
+    {
+        root |= bit;
+        if((unsigned int)root * root > value)
+        {
+            root &= ~bit;
+        }
+    }
+    return (root);
+}
+
+// Build the Q1 and Q2 lookup tables from their recorded ranges and the curve.
+void cal_build(unsigned char curve)
+{
+    unsigned char low;
+    unsigned char range;
+    unsigned int level;
+    unsigned char raw;
+
+    for(unsigned char s = 0; s != CAL_TABLES; s ++)
+    {
+        low = cal_min[s];
+        range = cal_max[s] - cal_min[s];
+        if(cal_max[s] < cal_min[s] || range < CAL_MIN_RANGE)
+        {
+            low = 0;            // No usable sweep - use a 1:1 mapping
+            range = 255;
+        }
+
+        raw = 0;
+        do
+        {
+            if(raw <= low)
+            {
+                level = 0;
+            }
+            else if(raw - low >= range)
+            {
+                level = 255;
+            }
+            else
+            {
+                level = (unsigned int)(raw - low) * 255 / range;
+            }
+
+            if(curve == CAL_GAMMA_2)
+            {
+                level = level * level / 255;
+            }
+            else if(curve == CAL_GAMMA_HALF)
+            {
+                level = cal_sqrt(level * 255);
+            }
+            cal_lut[s][raw] = (unsigned char)level;
+            raw ++;
+        } while(raw != 0);
+    }
+}
@@ -0,0 +1,73 @@
+/*==============================================================================
+ File: Calibration.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) light sensor calibration constant and function
+ definitions.
+
+ Calibration definitions section:
+ The raw 8-bit light levels read from each phototransistor only cover part of
+ the 0-255 range, and the range is different for each sensor. Calibration
+ records the lowest (lightest) and highest (darkest) level seen by each sensor
+ while the robot sweeps across the line, and then builds a 256-byte lookup
+ table for each of the Q1 and Q2 sensors that maps raw levels onto a
+ normalized 0-255 darkness level. Normalizing a sensor reading in the main loop
+ is then a single indexed table read. With SENSOR_ARRAY, the levels of every
+ sensor in the ADC scan list are recorded, but only Q1 and Q2 have tables (two
+ tables already use half of the RAM), and the sensor array normalizes its own
+ levels from the recorded ranges (see SensorArray.h). The curve constants
+ select an optional gamma curve for the table. If a sensor sees less than
+ CAL_MIN_RANGE difference between light and dark, its table is left as a
+ straight 1:1 mapping.
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the
+ Calibration.c file.
+==============================================================================*/
+
+// Calibration definitions
+#define CAL_SENSORS     ADC_SCAN_COUNT  // Number of calibrated sensors
+#define CAL_TABLES      2           // Sensors with tables (SCAN_Q1 and SCAN_Q2)
+#define CAL_MIN_RANGE   16          // Smallest usable light/dark level range
+#define CAL_LINEAR      0           // Linear (gamma 1.0) normalization curve
+#define CAL_GAMMA_2     1           // Gamma 2.0 curve - expands dark levels
+#define CAL_GAMMA_HALF  2           // Gamma 0.5 curve - expands light levels
+
+// Normalize a raw light level using the calibration table for sensor 's'
+#define CAL_NORM(s, raw)    (cal_lut[(s)][(raw)])
+
+// Calibration data
+extern unsigned char cal_min[CAL_SENSORS];      // Lightest raw level seen
+extern unsigned char cal_max[CAL_SENSORS];      // Darkest raw level seen
+extern unsigned char cal_lut[CAL_TABLES][256];  // Normalization tables
+
+// Prototypes for Calibration.c functions:
+
+/**
+ * Function: void cal_reset(void)
+ *
+ * Clear the recorded minimum and maximum levels before a calibration sweep.
+ */
+void cal_reset(void);
+
+/**
+ * Function: void cal_sample(unsigned char *levels)
+ *
+ * Update the recorded minimum and maximum levels using a set of CAL_SENSORS
+ * raw sensor levels (in ADC scan list order).
+ *
+ * Example usage: cal_sample(lightLevels);
+ */
+void cal_sample(unsigned char *);
+
+/**
+ * Function: void cal_build(unsigned char curve)
+ *
+ * Build the normalization lookup table for Q1 and Q2 from their recorded
+ * minimum and maximum levels using one of the curve constants, above. Raw
+ * levels outside of the recorded range are limited to 0 or 255. This takes a
+ * few milliseconds, so call it once after calibrating rather than in a loop.
+ *
+ * Example usage: cal_build(CAL_LINEAR);
+ */
+void cal_build(unsigned char);
@@ -0,0 +1,109 @@
+/*==============================================================================
+ File: Comparators.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) comparator line-edge detection functions
+
+ Functions to compare the Q1 and Q2 floor sensors with a DAC threshold using
+ the on-chip comparators, and to queue each line edge as a timestamped event.
+ These functions are only compiled when COMPARATORS is defined. Include the
+ Comparators.h file in your main program to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "Scheduler.h"       // Include scheduler time base functions
+#include    "Comparators.h"     // Include comparator constant & function definitions
+
+#ifdef COMPARATORS
+
+#define COMP_QUEUE_MASK (COMP_QUEUE_SIZE - 1)
+
+unsigned char comp_levels_queue[COMP_QUEUE_SIZE];   // Event Q2Q1 levels
+unsigned int comp_times_queue[COMP_QUEUE_SIZE];     // Event timestamps
+volatile unsigned char comp_head;   // Next queue entry to write
+volatile unsigned char comp_tail;   // Next queue entry to read
+
+// Start the DAC and both comparators, and enable their interrupts.
+void comp_start(unsigned char level)
+{
+    DACCON0 = 0b10000000;       // DAC on, VDD reference, no output pins
+    comp_threshold(level);
+    ANSELC = ANSELC | 0b00001100;   // Q1 & Q2 analog comparator inputs
+
+    CM1CON1 = 0b11010010;       // Both edges interrupt, + DAC, - C12IN2 (Q1)
+    CM2CON1 = 0b11010011;       // Both edges interrupt, + DAC, - C12IN3 (Q2)
+    CM1CON0 = 0b10010110;       // On, inverted (1 = dark), high speed,
+    CM2CON0 = 0b10010110;       // hysteresis, asynchronous, no output pin
+
+    comp_head = 0;
+    comp_tail = 0;
+    C1IF = 0;
+    C2IF = 0;
+    C1IE = 1;                   // Enable comparator interrupts
+    C2IE = 1;
+}
+
+// Stop the comparators and the DAC.
+void comp_stop(void)
+{
+    C1IE = 0;
+    C2IE = 0;
+    CM1CON0 = 0b00000000;       // Comparators off
+    CM2CON0 = 0b00000000;
+    DACCON0 = 0b00000000;       // DAC off
+    ANSELC = ANSELC & 0b11110011;   // Q1 & Q2 digital inputs
+}
+
+// Set the DAC output to level / 32 of VDD.
+void comp_threshold(unsigned char level)
+{
+    if(level > COMP_LEVEL_MAX)
+    {
+        level = COMP_LEVEL_MAX;
+    }
+    DACCON1 = level;
+}
+
+// Read both comparator outputs (MC1OUT is Q1, MC2OUT is Q2).
+unsigned char comp_levels(void)
+{
+    return (CMOUT & 0b00000011);
+}
+
+// Queue the comparator outputs at each edge.
+void comp_isr(void)
+{
+    unsigned char i = comp_head;
+    unsigned char next = (i + 1) & COMP_QUEUE_MASK;
+
+    C1IF = 0;                   // Clear the flags before reading the outputs
+    C2IF = 0;                   // so that a later edge interrupts again
+    if(next == comp_tail)
+    {
+        next = i;               // Queue full - replace the newest event
+        i = (i - 1) & COMP_QUEUE_MASK;
+    }
+    comp_levels_queue[i] = CMOUT & 0b00000011;
+    comp_times_queue[i] = sched_isr_time();
+    comp_head = next;
+}
+
+// Take the oldest queued event.
+bool comp_event(unsigned char *levels, unsigned int *time)
+{
+    unsigned char i = comp_tail;
+
+    if(i == comp_head)
+    {
+        return (false);         // No new edges
+    }
+    *levels = comp_levels_queue[i];
+    *time = comp_times_queue[i];
+    comp_tail = (i + 1) & COMP_QUEUE_MASK;
+    return (true);
+}
+
+#endif
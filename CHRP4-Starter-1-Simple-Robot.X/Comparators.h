@@ -0,0 +1,103 @@
+/*==============================================================================
+ File: Comparators.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) comparator line-edge detection constant and function
+ definitions.
+
+ Comparator enable section:
+ Comparator code is only compiled when COMPARATORS is defined, either by
+ removing the comment from the definition below or by adding COMPARATORS to
+ the project's XC8 compiler 'Define macros' setting. Comparator sensing is used
+ in digital mode, in place of reading Q1 and Q2 as logic inputs.
+
+ Comparator connections:
+ Floor sensor Q1 (RC2) is the C12IN2- input of comparator C1, and Q2 (RC3) is
+ the C12IN3- input of comparator C2. Both comparators compare their sensor
+ with the 5-bit DAC output, which divides VDD into 32 steps, so the light/dark
+ threshold tracks the phototransistor supply and can be set for each surface
+ instead of being fixed by the input buffer's logic level. The chip has only
+ one DAC, so both sensors share the same threshold. Hysteresis is enabled to
+ stop the outputs chattering at the line's edges. The outputs are inverted so
+ that, like the Q1 and Q2 inputs, 1 means dark.
+
+ Line-edge events:
+ Every change of either comparator output causes an interrupt, and comp_isr()
+ reads both outputs and queues them with a timestamp from the scheduler's
+ tick:TMR0 time base (2.67 us counts, see sched_isr_time()). The main program
+ takes the events from the queue with comp_event(), in order, so that an edge
+ that is crossed and uncrossed between two ticks is still seen. Between edges,
+ comp_event() just finds the queue empty. If the queue fills, the newest event
+ is replaced, so the latest sensor state is never lost. The handler has no
+ loops and takes about 60 instruction cycles (5 us).
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the Comparators.c
+ file.
+==============================================================================*/
+
+// Comparator enable definition
+//#define COMPARATORS
+
+// Comparator definitions
+#define COMP_THRESHOLD  16          // Default DAC threshold (VDD x n / 32)
+#define COMP_LEVEL_MAX  31          // Highest DAC threshold
+#define COMP_QUEUE_SIZE 8           // Edge event queue size (power of 2)
+
+#ifdef COMPARATORS
+
+// Prototypes for Comparators.c functions:
+
+/**
+ * Function: void comp_start(unsigned char level)
+ *
+ * Set the DAC threshold (0-31), switch Q1 and Q2 to analog inputs, clear the
+ * event queue, and start both comparators with interrupts on both edges.
+ *
+ * Example usage: comp_start(COMP_THRESHOLD);
+ */
+void comp_start(unsigned char);
+
+/**
+ * Function: void comp_stop(void)
+ *
+ * Turn off the comparators, their interrupts, and the DAC, and return Q1 and
+ * Q2 to digital inputs.
+ */
+void comp_stop(void);
+
+/**
+ * Function: void comp_threshold(unsigned char level)
+ *
+ * Change the DAC threshold (0-31). Higher thresholds need a darker surface for
+ * the sensor to read dark.
+ */
+void comp_threshold(unsigned char);
+
+/**
+ * Function: unsigned char comp_levels(void)
+ *
+ * Return the current comparator outputs as Q2Q1 bits (1 = dark).
+ */
+unsigned char comp_levels(void);
+
+/**
+ * Function: void comp_isr(void)
+ *
+ * Comparator interrupt handler. Clears both comparator interrupt flags and
+ * queues the comparator outputs and a timestamp.
+ */
+void comp_isr(void);
+
+/**
+ * Function: bool comp_event(unsigned char *levels, unsigned int *time)
+ *
+ * Take the oldest line-edge event from the queue. Returns true and sets the
+ * Q2Q1 levels and the edge timestamp, or returns false if there are no new
+ * edges.
+ *
+ * Example usage: while(comp_event(&sensors, &edgeTime))
+ */
+bool comp_event(unsigned char *, unsigned int *);
+
+#endif
@@ -0,0 +1,261 @@
+/*==============================================================================
+ File: Encoders.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) wheel encoder odometry and velocity loop functions
+
+ Interrupt-on-change edge counting for single-channel or quadrature wheel
+ encoders on H1-H4 (RB4-RB7), timed by the Timer0 tick scheduler, with wheel
+ speed, distance, and per-wheel PI velocity control. These functions are only
+ compiled when ENCODERS is defined. Include the Encoders.h file in your main
+ program to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "CHRP4.h"           // Include CHRP4 constant & function definitions
+#include    "Scheduler.h"       // Include scheduler time base functions
+#include    "Profiler.h"        // Include profiler enable definition
+#include    "Encoders.h"        // Include encoder constant & function definitions
+
+#ifdef ENCODERS
+
+int encoder_speed[2];               // Wheel speeds (motor speed units)
+long encoder_distance[2];           // Wheel distances (edges)
+
+volatile int encoder_count[2];      // Edge counts (wrap around)
+volatile unsigned int encoder_time[2];  // Last edge timestamps (TMR0 counts)
+volatile signed char encoder_dir[2] = {1, 1};   // Single-channel count direction
+unsigned char encoder_pins;         // Encoder pin states at the last edge
+int encoder_last_count[2];          // Edge counts at the last measured edge
+unsigned int encoder_last_time[2];  // Timestamps of the last measured edge
+bool encoder_moving[2];             // Last measured edge is recent
+int encoder_integral[2];            // Velocity loop speed error sums
+
+#ifdef ENCODER_QUADRATURE
+// Count change for each previous:current two-bit quadrature state (0 for no
+// change, or for an impossible change with both channels switching)
+const signed char encoder_steps[16] = {
+    0, -1, 1, 0,
+    1, 0, 0, -1,
+    -1, 0, 0, 1,
+    0, 1, -1, 0
+};
+#endif
+
+#ifdef PROFILE
+unsigned int encoder_isr_worst;     // Longest encoder_isr() time (cycles)
+
+// Read Timer1 (see Profiler.h). The profiler's own probe variables are used
+// by the main program, so the interrupt handler uses this separate copy.
+unsigned int encoder_cycles(void)
+{
+    unsigned char h;
+    unsigned int t;
+
+    do
+    {
+        h = TMR1H;
+        t = ((unsigned int)h << 8) | TMR1L;
+    } while(h != TMR1H);
+    return (t);
+}
+#endif
+
+// Clear the measurements and enable interrupt-on-change on both edges of the
+// encoder pins.
+void encoder_start(void)
+{
+    for(unsigned char w = 0; w != 2; w ++)
+    {
+        encoder_speed[w] = 0;
+        encoder_distance[w] = 0;
+        encoder_count[w] = 0;
+        encoder_last_count[w] = 0;
+        encoder_moving[w] = false;
+        encoder_integral[w] = 0;
+    }
+    encoder_pins = PORTB;
+    IOCBP = IOCBP | ENCODER_IOC;
+    IOCBN = IOCBN | ENCODER_IOC;
+    IOCBF = IOCBF & ~ENCODER_IOC;
+    IOCIE = 1;                  // Enable interrupt-on-change
+}
+
+// Count and timestamp the edges on the pins with pending flags.
+void encoder_edges(void)
+{
+    unsigned char flags = IOCBF & ENCODER_IOC;
+    unsigned int now;
+#ifdef ENCODER_QUADRATURE
+    unsigned char pins;
+#endif
+
+    IOCBF = IOCBF & ~flags;     // Clear only the flags being handled
+    now = sched_isr_time();
+#ifdef ENCODER_QUADRATURE
+    pins = PORTB;               // Read the pins after clearing their flags
+    if(flags & 0b00110000)
+    {
+        encoder_count[0] += encoder_steps[((encoder_pins >> 2) & 0b1100) |
+                                          ((pins >> 4) & 0b0011)];
+        encoder_time[0] = now;
+        encoder_pins = (encoder_pins & 0b11001111) | (pins & 0b00110000);
+    }
+    if(flags & 0b11000000)
+    {
+        encoder_count[1] += encoder_steps[((encoder_pins >> 4) & 0b1100) |
+                                          (pins >> 6)];
+        encoder_time[1] = now;
+        encoder_pins = (encoder_pins & 0b00111111) | (pins & 0b11000000);
+    }
+#else
+    if(flags & 0b00010000)
+    {
+        encoder_count[0] += encoder_dir[0];
+        encoder_time[0] = now;
+    }
+    if(flags & 0b00100000)
+    {
+        encoder_count[1] += encoder_dir[1];
+        encoder_time[1] = now;
+    }
+#endif
+}
+
+// Handle encoder edges, measuring the handler time if profiling.
+void encoder_isr(void)
+{
+#ifdef PROFILE
+    unsigned int start = encoder_cycles();
+    unsigned int time;
+#endif
+
+    encoder_edges();
+
+#ifdef PROFILE
+    time = encoder_cycles() - start;
+    if(time > encoder_isr_worst)
+    {
+        encoder_isr_worst = time;
+    }
+#endif
+}
+
+// Measure each wheel's speed from the edges counted since the last update and
+// the time between the last edges of this and the previous update.
+void encoder_update(void)
+{
+    unsigned int now = sched_time();
+    int count;
+    unsigned int time;
+    int edges;
+    unsigned int span;
+    int limit;
+
+    for(unsigned char w = 0; w != 2; w ++)
+    {
+        IOCIE = 0;              // Read the count and timestamp together
+        count = encoder_count[w];
+        time = encoder_time[w];
+        IOCIE = 1;
+
+        edges = count - encoder_last_count[w];
+        if(edges != 0)
+        {
+            encoder_last_count[w] = count;
+            if(w == ENCODER_LEFT ? ENCODER_L_INVERT : ENCODER_R_INVERT)
+            {
+                edges = -edges;
+            }
+            encoder_distance[w] += edges;
+            if(encoder_moving[w])
+            {
+                span = time - encoder_last_time[w];
+                if(span == 0)
+                {
+                    span = 1;
+                }
+                encoder_speed[w] = (int)((long)edges * ENCODER_RATE_K / span);
+            }
+            encoder_last_time[w] = time;
+            encoder_moving[w] = true;   // Speed can be measured from this edge
+        }
+        else if(encoder_moving[w])
+        {
+            span = now - encoder_last_time[w];
+            if(span > ENCODER_TIMEOUT)
+            {
+                encoder_moving[w] = false;  // Stopped
+                encoder_speed[w] = 0;
+            }
+            else
+            {
+                limit = (int)(ENCODER_RATE_K / span);   // At most one edge
+                if(encoder_speed[w] > limit)            // in this time
+                {
+                    encoder_speed[w] = limit;
+                }
+                else if(encoder_speed[w] < -limit)
+                {
+                    encoder_speed[w] = -limit;
+                }
+            }
+        }
+    }
+}
+
+// PI velocity loop - drive the wheel at its speed command plus the corrections
+// for its speed error and accumulated speed error.
+int encoder_control(unsigned char wheel, int speed)
+{
+    int error;
+    int drive;
+
+    encoder_dir[wheel] = (speed < 0) ? -1 : 1;
+    if(speed == 0)
+    {
+        encoder_integral[wheel] = 0;
+        return (0);
+    }
+
+    error = speed - encoder_speed[wheel];
+    encoder_integral[wheel] += error;
+    if(encoder_integral[wheel] > ENCODER_I_MAX)
+    {
+        encoder_integral[wheel] = ENCODER_I_MAX;
+    }
+    else if(encoder_integral[wheel] < -ENCODER_I_MAX)
+    {
+        encoder_integral[wheel] = -ENCODER_I_MAX;
+    }
+
+    drive = speed + ((error * ENCODER_KP) >> 4) +
+            ((encoder_integral[wheel] * ENCODER_KI) >> 4);
+    if(drive > 255)
+    {
+        return (255);
+    }
+    if(drive < -255)
+    {
+        return (-255);
+    }
+    return (drive);
+}
+
+// Convert the wheel speed to revolutions per minute.
+int encoder_rpm(unsigned char wheel)
+{
+    return ((int)((long)encoder_speed[wheel] * (ENCODER_MAX_RATE * 60L) /
+                  (255L * ENCODER_EDGES_REV)));
+}
+
+// Convert the wheel distance to millimetres.
+long encoder_mm(unsigned char wheel)
+{
+    return ((encoder_distance[wheel] * ENCODER_MM_Q12) >> 12);
+}
+
+#endif
@@ -0,0 +1,159 @@
+/*==============================================================================
+ File: Encoders.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) wheel encoder odometry and velocity loop constant and
+ function definitions.
+
+ Encoder enable section:
+ Encoder code is only compiled when ENCODERS is defined, either by removing the
+ comment from the definition below or by adding ENCODERS to the project's XC8
+ compiler 'Define macros' setting. Also define ENCODER_QUADRATURE for two-
+ channel (quadrature) encoders.
+
+ Encoder connections:
+ Single-channel encoders connect to H1 (RB4, left wheel) and H2 (RB5, right
+ wheel). Quadrature encoders connect their A and B channels to H1 and H2 (left
+ wheel) and H3 and H4 (right wheel). The encoder pins are shared with
+ pushbuttons SW2-SW5, which stop being sampled once the encoders start (see
+ buttons_mask()). H2 and H3 are also the SONAR TRIG and ECHO pins, and H4 is
+ the IR remote and telemetry pin, so SONAR cannot be used with encoders, and
+ the IR remote and telemetry cannot be used with quadrature encoders.
+
+ Edge counting:
+ Every edge of every encoder channel causes an interrupt-on-change, and
+ encoder_isr() counts it and timestamps it with the scheduler's tick:TMR0
+ time base (2.67 us counts, see sched_isr_time()). Quadrature edges are
+ counted up or down using a 16-entry state transition table (4 counts per
+ encoder cycle), and single-channel edges are counted in the direction of the
+ wheel's last speed command (2 counts per encoder cycle). The handler has no
+ loops, so its cost per interrupt is fixed: about 120 instruction cycles
+ (10 us) for one wheel and 200 (17 us) for both, plus interrupt entry and
+ exit. At 10,000 edges per second, the encoders use about 12% of the CPU
+ time. Define PROFILE to measure the longest handler time in encoder_isr_worst
+ (see Profiler.h).
+
+ Speed and distance:
+ encoder_update() runs from a scheduler task every ENCODER_PERIOD ticks. It
+ divides the edges counted since its last update by the time between the
+ first and last of their timestamps, so the speed measurement is as precise as
+ the edge timestamps rather than the update period. If no edges arrive, the
+ speed decays as if an edge were just about to arrive, and is zero after
+ ENCODER_TIMEOUT. Speeds are in motor speed units (ENCODER_MAX_RATE edges per
+ second is a speed of 255), and encoder_rpm() and encoder_mm() convert the
+ speed and the total distance to wheel RPM and millimetres. encoder_mm() uses
+ a 12-bit fraction of a millimetre per edge, which is accurate to 0.1% and
+ does not overflow for about 500 m.
+
+ Odometry telemetry:
+ When telemetry is available (single-channel encoders, see Telemetry.h), the
+ main program's odometry task sends a statistics frame with the ID ENCODER_ID
+ every 43.7 ms while line following. It holds the left and right wheel RPM
+ and the mean distance travelled by the two wheels in millimetres, as signed
+ 16-bit values. Converting them takes about 4000 instruction cycles of long
+ arithmetic, so the task has a larger budget than the telemetry task.
+
+ Velocity loop:
+ encoder_control() is a PI controller that makes each wheel follow its speed
+ command. It uses the command itself as the open-loop (feedforward) motor
+ speed, and corrects it by the speed error multiplied by ENCODER_KP plus the
+ accumulated speed error multiplied by ENCODER_KI, so a weaker motor is driven
+ harder until both wheels turn at their commanded speeds. Set ENCODER_MAX_RATE
+ to the edge rate measured at full speed before tuning the gains.
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the Encoders.c
+ file.
+==============================================================================*/
+
+// Encoder enable definitions
+//#define ENCODERS
+//#define ENCODER_QUADRATURE
+
+// Encoder and wheel definitions
+#define ENCODER_CPR     7           // Encoder cycles per motor revolution
+#define ENCODER_GEAR    30          // Motor revolutions per wheel revolution
+#define ENCODER_WHEEL_UM 100531     // Wheel circumference (um, 32 mm wheel)
+#define ENCODER_L_INVERT 0          // 1 if the left wheel counts backwards
+#define ENCODER_R_INVERT 0          // 1 if the right wheel counts backwards
+#ifdef ENCODER_QUADRATURE
+#define ENCODER_EDGES   4           // Counted edges per encoder cycle
+#define ENCODER_IOC     0b11110000  // H1-H4 (RB4-RB7) interrupt-on-change bits
+#else
+#define ENCODER_EDGES   2
+#define ENCODER_IOC     0b00110000  // H1-H2 (RB4-RB5) interrupt-on-change bits
+#endif
+#define ENCODER_EDGES_REV (ENCODER_CPR * ENCODER_EDGES * ENCODER_GEAR)
+#define ENCODER_MM_Q12  (ENCODER_WHEEL_UM * 4096L / 1000 / ENCODER_EDGES_REV) // mm/edge
+
+// Speed measurement and velocity loop definitions
+#define ENCODER_LEFT    0           // Left wheel index
+#define ENCODER_RIGHT   1           // Right wheel index
+#define ENCODER_PERIOD  8           // Ticks between updates (5.5 ms)
+#define ENCODER_TIMEOUT 37500       // No edges for this long is stopped (100 ms)
+#define ENCODER_MAX_RATE 3000       // Edges per second at full speed (255)
+#define ENCODER_RATE_K  (375000L * 255 / ENCODER_MAX_RATE)  // Speed x counts
+#define ENCODER_KP      8           // Proportional gain (Q4.4)
+#define ENCODER_KI      2           // Integral gain (Q4.4)
+#define ENCODER_I_MAX   1024        // Integral speed error limit
+#define ENCODER_ID      0x30        // Odometry statistics frame ID (see Telemetry.h)
+
+#ifdef ENCODERS
+
+extern int encoder_speed[2];        // Wheel speeds (motor speed units)
+extern long encoder_distance[2];    // Wheel distances (edges)
+#ifdef PROFILE
+extern unsigned int encoder_isr_worst;  // Longest encoder_isr() time (cycles)
+#endif
+
+// Prototypes for Encoders.c functions:
+
+/**
+ * Function: void encoder_start(void)
+ *
+ * Clear the speeds, distances, and velocity loops, and enable interrupt-on-
+ * change on both edges of every encoder pin.
+ */
+void encoder_start(void);
+
+/**
+ * Function: void encoder_isr(void)
+ *
+ * Encoder interrupt-on-change handler. Counts and timestamps the edges on all
+ * encoder pins with pending interrupt flags.
+ */
+void encoder_isr(void);
+
+/**
+ * Function: void encoder_update(void)
+ *
+ * Measure the wheel speeds and add the new edges to the wheel distances. Call
+ * from a scheduler task every ENCODER_PERIOD ticks.
+ */
+void encoder_update(void);
+
+/**
+ * Function: int encoder_control(unsigned char wheel, int speed)
+ *
+ * Update the wheel's velocity loop with its speed command (-255 to 255), and
+ * return the motor speed to drive it with. Call after encoder_update().
+ *
+ * Example usage: leftDrive = encoder_control(ENCODER_LEFT, leftSpeed);
+ */
+int encoder_control(unsigned char, int);
+
+/**
+ * Function: int encoder_rpm(unsigned char wheel)
+ *
+ * Return the wheel's speed in revolutions per minute.
+ */
+int encoder_rpm(unsigned char);
+
+/**
+ * Function: long encoder_mm(unsigned char wheel)
+ *
+ * Return the distance the wheel has travelled in millimetres.
+ */
+long encoder_mm(unsigned char);
+
+#endif
@@ -0,0 +1,137 @@
+/*==============================================================================
+ File: Motors.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) background motor drive functions
+
+ Motor speed control functions using the PIC16F1459 PWM1 and PWM2 modules
+ instead of the software pwm_motors() delay loop. The PWM hardware generates
+ the motor pulses on its own, so setting a new motor speed only takes a few
+ register writes and the main program loop is free to read the sensors again
+ right away. Include the Motors.h file in your main program to call these
+ functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "CHRP4.h"           // Include CHRP4 constant & function definitions
+#include    "Motors.h"          // Include motor constant & function definitions
+
+unsigned char motor_scale = MOTOR_SCALE_ONE;    // Supply compensation (Q7)
+unsigned int motor_fvr_sum;         // FVR reading IIR filter sum (4 readings)
+
+// Configure Timer2 and PWM1/PWM2 for background motor drive. PWM outputs stay
+// disconnected from M1B and M2A until the first motor_set_speed() call.
+void motor_config(void)
+{
+    PWM1CON = 0;                // Disable PWM modules while configuring them
+    PWM2CON = 0;
+    PWM1DCH = 0;                // Clear both duty cycles (motors off)
+    PWM1DCL = 0;
+    PWM2DCH = 0;
+    PWM2DCL = 0;
+
+    PR2 = MOTOR_PWM_PR2;        // Set PWM period to 255 duty cycle steps
+    TMR2IF = 0;
+    T2CON = MOTOR_PWM_T2CON;    // Start Timer2 with 1:16 prescaler (2.94 kHz)
+
+    PWM1CON = MOTOR_PWM_OFF;    // Enable PWMs, but leave motor pins on LATC
+    PWM2CON = MOTOR_PWM_OFF;
+}
+
+// Convert a signed speed to a supply-compensated duty cycle (0-255).
+unsigned char motor_duty(int speed)
+{
+    unsigned int duty;
+
+    if(speed < 0)
+    {
+        speed = -speed;
+    }
+    if(speed > 255)
+    {
+        speed = 255;
+    }
+    duty = ((unsigned int)speed * motor_scale) >> 7;
+    return ((duty > 255) ? 255 : (unsigned char)duty);
+}
+
+// Set the signed speed (-255 to 255) of the left (M1) and right (M2) motors.
+// Each motor's non-PWM pin is held high for drive/brake modulation, or low for
+// drive/coast modulation, and its PWM output polarity is set to match. Duty
+// cycle registers are double-buffered, so new speeds take effect at the start
+// of the next PWM period without glitching the current pulse.
+void motor_drive(int left, int right)
+{
+    unsigned char hold = 0;
+    unsigned char pwm1 = MOTOR_PWM_HIGH;
+    unsigned char pwm2 = MOTOR_PWM_HIGH;
+
+    if((left >= 0) != MOTOR_L_SWAP)
+    {
+        hold |= 1 << MOTOR_M1A_BIT; // Hold M1A high, PWM M1B low to drive
+        pwm1 = MOTOR_PWM_LOW;
+    }
+    if((right >= 0) != MOTOR_R_SWAP)
+    {
+        hold |= 1 << MOTOR_M2B_BIT; // Hold M2B high, PWM M2A low to drive
+        pwm2 = MOTOR_PWM_LOW;
+    }
+    PWM1DCH = motor_duty(left); // Duty cycle MSBs (PWMxDCL LSBs stay cleared)
+    PWM2DCH = motor_duty(right);
+    MOTOR_WRITE(hold);
+    PWM1CON = pwm1;
+    PWM2CON = pwm2;
+}
+
+// Set the forward speed (0-255) of the left (M1) and right (M2) motors.
+void motor_set_speed(unsigned char left, unsigned char right)
+{
+    motor_drive(left, right);
+}
+
+// Short both motors' terminals together (11) to brake them.
+void motor_brake(void)
+{
+    motor_release();
+    MOTOR_WRITE(MOTOR_MASK);
+}
+
+// Leave both motors' terminals undriven (00) so that they coast.
+void motor_coast(void)
+{
+    motor_release();
+    MOTOR_WRITE(0);
+}
+
+// Update the supply compensation scale factor, MOTOR_VNOM_MV / VDD, from the
+// filtered FVR reading (1023 x ADC_FVR_MV / VDD).
+void motor_supply(unsigned int fvr)
+{
+    unsigned long scale;
+
+    if(fvr == 0)
+    {
+        return;
+    }
+    if(motor_fvr_sum == 0)
+    {
+        motor_fvr_sum = fvr << 2;   // Start the filter at the first reading
+    }
+    else
+    {
+        motor_fvr_sum += fvr - (motor_fvr_sum >> 2);
+    }
+    scale = ((unsigned long)motor_fvr_sum * MOTOR_SUPPLY_K) >> 12;
+    motor_scale = (scale > 255) ? 255 : (unsigned char)scale;
+}
+
+// Return the M1B and M2A pins to their LATC bits, so that LATC motor constants
+// control both motors again.
+void motor_release(void)
+{
+    PWM1CON = MOTOR_PWM_OFF;
+    PWM2CON = MOTOR_PWM_OFF;
+}
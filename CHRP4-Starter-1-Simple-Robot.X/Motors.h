@@ -0,0 +1,172 @@
+/*==============================================================================
+ File: Motors.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) background motor drive constant and function definitions.
+
+ Motor pin map section:
+ The LATC bit used for each motor driver input, and whether each motor is
+ wired in reverse, are declared once here. Each motor drives forward when its
+ 'forward' pin is high and its other pin is low -- M1A and M2B unless the
+ motor's swap flag is set (set a swap flag instead of swapping the motor's
+ wires on the CON1 motor header if the motor runs in reverse). The motor
+ direction bits MOTOR_L_FWD, MOTOR_L_REV, MOTOR_R_FWD, and MOTOR_R_REV are
+ derived from the map at compile time, and are combined into LATC direction
+ constants by the main program. Compile-time assertions stop the build if two
+ motor pins overlap, if a motor pin overlaps the floor sensor LED or
+ phototransistor pins, or if M1B and M2A are moved off the PWM1 and PWM2 pins.
+
+ MOTOR_WRITE(dir) updates all four motor pins using a single atomic write to
+ LATC. It computes which motor bits must change, and flips just those bits
+ with one XOR instruction (xorwf LATC), so the other LATC bits -- including
+ the floor sensor LEDs, which the ADC interrupt toggles during synchronous
+ sensing -- are never rewritten. The motor pins never pass through an
+ intermediate state.
+
+ Motor PWM definitions section:
+ The PIC16F1459 PWM1 and PWM2 modules share their output pins with the M1B
+ (RC5) and M2A (RC6) motor outputs, and are clocked by Timer2. Setting PR2 to
+ 254 makes the PWM period exactly 255 duty steps long, so a duty value of 255
+ keeps a motor fully on just like the software pwm_motors() function did. With
+ a 1:16 Timer2 prescaler at 48 MHz the PWM frequency is 12 MHz / 16 / 255, or
+ about 2.94 kHz -- roughly four times the rate of the software PWM loop.
+
+ Signed motor drive section:
+ Only one pin of each motor can be pulse-width modulated: the 'B' side of M1
+ and the 'A' side of M2. motor_drive() sets each motor's other pin (M1A or
+ M2B) and its PWM output polarity from the direction of its signed speed:
+
+   Held pin   PWM output    During the duty cycle     Rest of the period
+   high       active-low    drive, held pin high      brake (both pins high)
+   low        active-high   drive, PWM pin high       coast (both pins low)
+
+ For an unswapped motor the first row is forward and the second is reverse
+ (a swap flag exchanges them), so a motor spends the rest of each PWM period
+ braking while going forward and coasting while reversing. A reversing inner
+ wheel slows the robot into a corner more sharply than a coasting one, and
+ motor_brake() and motor_coast() hold both motors in the steady 11 (brake) or
+ 00 (coast) states through LATC. The PWM output polarity changes immediately
+ while the new duty cycle waits for the next period, so a reversal can run in
+ the new direction at the old duty cycle for up to one PWM period (340 us).
+
+ Supply compensation section:
+ The average motor voltage is the duty cycle multiplied by the supply voltage,
+ so as the batteries discharge the same speed value drives the motors more
+ slowly. motor_supply() takes the ADC scan engine's FVR reading (see CHRP4.h),
+ which is inversely proportional to the supply voltage, and sets a scale
+ factor of MOTOR_VNOM_MV / VDD that motor_set_speed() applies to both duty
+ cycles, so each speed value gives the same average motor voltage as it would
+ at MOTOR_VNOM_MV. Because the FVR reading is already the reciprocal of VDD,
+ the scale factor is just the (IIR-filtered) reading multiplied by a constant,
+ and no division or reciprocal table is needed. Speeds that would need more
+ than the supply voltage are limited to full on, so set MOTOR_VNOM_MV to the
+ lowest supply voltage the robot should keep its speed at. The scale factor
+ starts at 1, and is only updated while the ADC scan is running (analog mode).
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the Motors.c file.
+==============================================================================*/
+
+// Motor pin map (LATC bit numbers and reversed motor flags)
+#define MOTOR_M1A_BIT   4           // Motor 1 (left) A input, RC4
+#define MOTOR_M1B_BIT   5           // Motor 1 (left) B input, RC5 (PWM1)
+#define MOTOR_M2A_BIT   6           // Motor 2 (right) A input, RC6 (PWM2)
+#define MOTOR_M2B_BIT   7           // Motor 2 (right) B input, RC7
+#define MOTOR_L_SWAP    0           // 1 if the left motor is wired in reverse
+#define MOTOR_R_SWAP    0           // 1 if the right motor is wired in reverse
+
+// Motor direction bits derived from the pin map
+#define MOTOR_L_FWD     (1 << (MOTOR_L_SWAP ? MOTOR_M1B_BIT : MOTOR_M1A_BIT))
+#define MOTOR_L_REV     (1 << (MOTOR_L_SWAP ? MOTOR_M1A_BIT : MOTOR_M1B_BIT))
+#define MOTOR_R_FWD     (1 << (MOTOR_R_SWAP ? MOTOR_M2A_BIT : MOTOR_M2B_BIT))
+#define MOTOR_R_REV     (1 << (MOTOR_R_SWAP ? MOTOR_M2B_BIT : MOTOR_M2A_BIT))
+#define MOTOR_MASK      (MOTOR_L_FWD | MOTOR_L_REV | MOTOR_R_FWD | MOTOR_R_REV)
+#define MOTOR_SENSOR_PINS 0b00001111    // Floor LEDs (RC0-1) and Q1/Q2 (RC2-3)
+
+// Compile-time assertions (a negative array size stops the build)
+#define MOTOR_ASSERT(name, test) typedef char name[(test) ? 1 : -1]
+MOTOR_ASSERT(motor_pins_overlap, MOTOR_MASK == MOTOR_L_FWD + MOTOR_L_REV +
+             MOTOR_R_FWD + MOTOR_R_REV);
+MOTOR_ASSERT(motor_pins_use_sensor_pins, (MOTOR_MASK & MOTOR_SENSOR_PINS) == 0);
+MOTOR_ASSERT(motor_pins_not_pwm, MOTOR_M1B_BIT == 5 && MOTOR_M2A_BIT == 6);
+
+// Write a direction constant to the motor pins in one atomic LATC update
+#define MOTOR_WRITE(dir)    (LATC ^= (LATC ^ (dir)) & MOTOR_MASK)
+
+// Motor PWM definitions
+#define MOTOR_PWM_PR2   254         // Timer2 period for 255-step duty cycles
+#define MOTOR_PWM_T2CON 0b00000110  // Timer2 on, 1:1 postscale, 1:16 prescale
+#define MOTOR_PWM_LOW   0b11010000  // PWMx enabled, output on, active-low
+#define MOTOR_PWM_HIGH  0b11000000  // PWMx enabled, output on, active-high
+#define MOTOR_PWM_OFF   0b10000000  // PWMx enabled, output pin follows LATC
+
+// Motor supply compensation definitions
+#define MOTOR_VNOM_MV   4500        // Supply voltage speeds are tuned for (mV)
+#define MOTOR_SCALE_ONE 128         // Duty cycle scale factor of 1 (Q7)
+#define MOTOR_SUPPLY_K  ((unsigned long)MOTOR_VNOM_MV * 32 * 4096 / \
+                         ((unsigned long)ADC_FVR_MV * 1023))    // Q12
+
+// Prototypes for Motors.c functions:
+
+/**
+ * Function: void motor_config(void)
+ *
+ * Configure Timer2 and the PWM1/PWM2 modules for background motor drive. The
+ * PWM outputs are left disconnected from the motor pins (so LATC motor
+ * constants still work) until motor_set_speed() is first called.
+ */
+void motor_config(void);
+
+/**
+ * Function: void motor_drive(int left, int right)
+ *
+ * Set the signed speed (-255 to 255, negative = reverse) of the left (M1) and
+ * right (M2) motors. The new duty cycles are latched by the PWM hardware at
+ * the start of the next PWM period, so this function returns immediately
+ * without blocking.
+ *
+ * Example usage: motor_drive(leftSpeed, rightSpeed);
+ */
+void motor_drive(int, int);
+
+/**
+ * Function: void motor_set_speed(unsigned char left, unsigned char right)
+ *
+ * Set the forward speed (0-255) of the left (M1) and right (M2) motors.
+ *
+ * Example usage: motor_set_speed(lightLevelRight, lightLevelLeft);
+ */
+void motor_set_speed(unsigned char, unsigned char);
+
+/**
+ * Function: void motor_brake(void)
+ *
+ * Brake both motors by shorting their terminals together (11), lighting LEDs
+ * D2-D5.
+ */
+void motor_brake(void);
+
+/**
+ * Function: void motor_coast(void)
+ *
+ * Let both motors coast by turning off both sides of each motor driver (00).
+ */
+void motor_coast(void);
+
+/**
+ * Function: void motor_supply(unsigned int fvr)
+ *
+ * Filter a 10-bit FVR supply reading and update the duty cycle scale factor
+ * used by motor_set_speed(). Readings of 0 (no reading yet) are ignored.
+ *
+ * Example usage: motor_supply(ADC_scan_fvr());
+ */
+void motor_supply(unsigned int);
+
+/**
+ * Function: void motor_release(void)
+ *
+ * Disconnect the PWM outputs from the motor pins and return control of both
+ * motors to the LATC motor constants.
+ */
+void motor_release(void);
@@ -0,0 +1,84 @@
+/*==============================================================================
+ File: PID.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) fixed-point PID line-following controller functions
+
+ Proportional-integral-derivative (PID) steering control using 16-bit integer
+ arithmetic and Q4.4 fixed-point gains. Gains are applied with shift-and-add
+ multiplication, since the PIC16F1459 has no hardware multiplier. Include the
+ PID.h file in your main program to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "PID.h"             // Include PID constant & function definitions
+
+unsigned char pid_kp = PID_KP;  // Proportional gain (Q4.4)
+unsigned char pid_ki = PID_KI;  // Integral gain (Q4.4)
+unsigned char pid_kd = PID_KD;  // Derivative gain (Q4.4)
+unsigned char pid_base = PID_BASE;  // Base motor speed
+
+int pid_integral;               // Clamped sum of errors
+int pid_last;                   // Previous position measurement
+
+// Multiply x by the Q4.4 gain k using shift-and-add. The whole and fraction
+// nibbles of the gain are accumulated separately so that |x| values of up to
+// 2047 cannot overflow, and the fraction sum is scaled down by 16 at the end.
+int pid_mul(int x, unsigned char k)
+{
+    unsigned char whole = k >> 4;
+    unsigned char frac = k & 0x0F;
+    int wholeSum = 0;
+    int fracSum = 0;
+
+    for(unsigned char i = 4; i != 0; i --)
+    {
+        if(whole & 1)
+        {
+            wholeSum += x;
+        }
+        if(frac & 1)
+        {
+            fracSum += x;
+        }
+        whole >>= 1;
+        frac >>= 1;
+        x <<= 1;
+    }
+    return (wholeSum + (fracSum >> 4));
+}
+
+// Clear the integral sum and previous measurement.
+void pid_reset(void)
+{
+    pid_integral = 0;
+    pid_last = 0;
+}
+
+// Run one PID update for the measured line position (setpoint is centre, 0),
+// and return the steering correction.
+int pid_update(int position)
+{
+    int error = -position;
+    int output;
+
+    pid_integral += error;      // Sum errors, clamping to prevent windup
+    if(pid_integral > PID_I_LIMIT)
+    {
+        pid_integral = PID_I_LIMIT;
+    }
+    else if(pid_integral < -PID_I_LIMIT)
+    {
+        pid_integral = -PID_I_LIMIT;
+    }
+
+    output = pid_mul(error, pid_kp);
+    output += pid_mul(pid_integral, pid_ki) >> PID_I_SHIFT;
+    output -= pid_mul(position - pid_last, pid_kd); // Derivative on measurement
+    pid_last = position;
+
+    return (output);
+}
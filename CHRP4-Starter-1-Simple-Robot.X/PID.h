@@ -0,0 +1,74 @@
+/*==============================================================================
+ File: PID.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) fixed-point PID line-following controller constant and
+ function definitions.
+
+ PID parameter definitions section:
+ Gains are unsigned Q4.4 fixed-point values (the upper four bits hold the
+ whole number part, the lower four bits hold sixteenths), so a gain of 0x18
+ is 1.5 and the available range is 0 to 15.9375 in steps of 0.0625. The
+ integral sum is clamped to +/-PID_I_LIMIT to prevent integral windup, and is
+ divided by 2^PID_I_SHIFT before its gain is applied.
+
+ Update cost:
+ The PIC16F1459 has no hardware multiplier, so each gain is applied by a four
+ step shift-and-add multiply of the whole and fraction nibbles. One PID update
+ takes roughly 600 instruction cycles (50 us, or 19 TMR0 counts) when built
+ without optimizations, which is well within a single scheduler tick.
+
+ Tuning:
+ The default gains were checked with the host simulator's base speed sweep
+ (make sweep in tools/sim), which raises the base speed in SPEED_STEP steps
+ until the robot loses the line. With these gains the robot keeps the line on
+ every test track up to a base speed of 248, the last step below full speed.
+ The derivative gain is large because the position only changes by a few
+ counts in each 683 us update. With a derivative gain of 2.0 the robot still
+ kept the line, but weaved about it with steering swings of about +/-120,
+ which slowed it down and hid the track shape from the track log (Track.h).
+ The original steering, in which each motor ran at the opposite sensor's
+ level (proportional-only, with a gain of 0.5), loses the line at a base
+ speed of 168 on the square track, 192 on the chicane and 240 on the oval.
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the PID.c file.
+==============================================================================*/
+
+// PID parameter definitions
+#define PID_KP      0x18            // Default proportional gain (1.5)
+#define PID_KI      0x01            // Default integral gain (0.0625)
+#define PID_KD      0xE0            // Default derivative gain (14.0)
+#define PID_BASE    160             // Default base motor speed (0-255)
+#define PID_I_LIMIT 1023            // Integral windup clamp (+/- error sum)
+#define PID_I_SHIFT 2               // Integral sum scaling (divide by 4)
+
+// PID parameters (may be changed while running)
+extern unsigned char pid_kp;        // Proportional gain (Q4.4)
+extern unsigned char pid_ki;        // Integral gain (Q4.4)
+extern unsigned char pid_kd;        // Derivative gain (Q4.4)
+extern unsigned char pid_base;      // Base motor speed (0-255)
+
+// Prototypes for PID.c functions:
+
+/**
+ * Function: void pid_reset(void)
+ *
+ * Clear the integral sum and the previous measurement. Call this before
+ * starting the controller, or after the robot has been stopped or moved.
+ */
+void pid_reset(void);
+
+/**
+ * Function: int pid_update(int position)
+ *
+ * Run one PID controller update using the measured line position (left sensor
+ * level minus right sensor level, so positive values mean the line is to the
+ * left of centre). Returns a steering correction to add to the left motor
+ * speed and subtract from the right motor speed. The derivative term acts on
+ * the measured position rather than on the error, so setpoint changes do not
+ * cause derivative kicks.
+ *
+ * Example usage: steering = pid_update(lightLevelLeft - lightLevelRight);
+ */
+int pid_update(int);
@@ -0,0 +1,191 @@
+/*==============================================================================
+ File: Params.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) High-Endurance Flash parameter store functions
+
+ Functions to load and save versioned, CRC-checked parameter records in the
+ four High-Endurance Flash rows, levelling wear across the rows. Include the
+ Params.h file in your main program to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "CHRP4.h"           // Include CHRP4 constant & function definitions
+#include    "Calibration.h"     // Include calibrated sensor count
+#include    "Params.h"          // Include parameter store definitions
+
+unsigned char param_row = PARAM_ROWS - 1;   // Row holding the newest record
+unsigned char param_sequence;       // Sequence number of the newest record
+
+// Read the low byte of a program memory word.
+unsigned char param_read(unsigned int address)
+{
+    PMADRL = (unsigned char)address;
+    PMADRH = (unsigned char)(address >> 8);
+    CFGS = 0;                   // Program memory, not configuration memory
+    RD = 1;
+    NOP();                      // Required after setting RD
+    NOP();
+    return (PMDATL);
+}
+
+// Add one byte to a CRC-8 (polynomial x^8 + x^2 + x + 1).
+unsigned char param_crc(unsigned char crc, unsigned char data)
+{
+    crc ^= data;
+    for(unsigned char b = 0; b != 8; b ++)
+    {
+        if(crc & 0x80)
+        {
+            crc = (unsigned char)(crc << 1) ^ 0x07;
+        }
+        else
+        {
+            crc <<= 1;
+        }
+    }
+    return (crc);
+}
+
+// Start a flash erase or write with the required unlock sequence.
+void param_unlock(void)
+{
+    PMCON2 = 0x55;
+    PMCON2 = 0xAA;
+    WR = 1;                     // CPU stalls until the operation completes
+    NOP();
+    NOP();
+}
+
+// Program the version byte of a row on its own, leaving the rest of the row
+// as it is (programming can only clear bits).
+void param_mark(unsigned int address, unsigned char version)
+{
+    PMADRL = (unsigned char)address;
+    PMADRH = (unsigned char)(address >> 8);
+    PMDATL = version;
+    PMDATH = 0x3F;
+    LWLO = 0;                   // Write the row with only this latch loaded
+    param_unlock();
+}
+
+// Load the newest record with a valid CRC. Rows are tried newest first by
+// sequence number, so a record damaged by a power failure during a save is
+// skipped in favour of the record saved before it.
+bool param_load(param_t *params)
+{
+    unsigned char record[PARAM_SIZE];
+    unsigned char tried = 0;
+    unsigned char newest;
+    unsigned char crc;
+    unsigned int address;
+
+    for(unsigned char pass = 0; pass != PARAM_ROWS; pass ++)
+    {
+        newest = PARAM_ROWS;
+        for(unsigned char row = 0; row != PARAM_ROWS; row ++)
+        {
+            address = PARAM_HEF + row * PARAM_ROW_SIZE;
+            if((tried & (1 << row)) || param_read(address) != PARAM_VERSION)
+            {
+                continue;
+            }
+            record[1] = param_read(address + 1);
+            if(newest == PARAM_ROWS ||
+               (signed char)(record[1] - param_sequence) > 0)
+            {
+                newest = row;
+                param_sequence = record[1];
+            }
+        }
+        if(newest == PARAM_ROWS)
+        {
+            break;              // No more records to try
+        }
+        tried |= 1 << newest;
+
+        address = PARAM_HEF + newest * PARAM_ROW_SIZE;
+        crc = 0;
+        for(unsigned char i = 0; i != PARAM_SIZE; i ++)
+        {
+            record[i] = param_read(address + i);
+            if(i != PARAM_SIZE - 1)
+            {
+                crc = param_crc(crc, record[i]);
+            }
+        }
+        if(crc == record[PARAM_SIZE - 1])
+        {
+            param_row = newest;
+            for(unsigned char i = 0; i != PARAM_SIZE; i ++)
+            {
+                ((unsigned char *)params)[i] = record[i];
+            }
+            return (true);
+        }
+    }
+    param_row = PARAM_ROWS - 1;
+    param_sequence = 0;
+    return (false);
+}
+
+// Erase the row after the newest record and write the new record into it.
+// A valid version byte in the row is cleared before the erase, and the new
+// record's version byte is written last, so that a row left part erased or
+// part written by a power failure is never taken for a record. A damaged
+// version byte is left alone, as clearing some of its bits could make it
+// valid again.
+void param_save(param_t *params)
+{
+    unsigned char *data = (unsigned char *)params;
+    unsigned char gie = GIE;
+    unsigned char crc = 0;
+    bool valid;
+    unsigned int address;
+
+    params->version = PARAM_VERSION;
+    params->sequence = param_sequence + 1;
+    for(unsigned char i = 0; i != PARAM_SIZE - 1; i ++)
+    {
+        crc = param_crc(crc, data[i]);
+    }
+    params->crc = crc;
+
+    param_row = (param_row + 1) & (PARAM_ROWS - 1);
+    address = PARAM_HEF + param_row * PARAM_ROW_SIZE;
+
+    valid = param_read(address) == PARAM_VERSION;
+    GIE = 0;                    // No interrupts during the unlock sequences
+    CFGS = 0;
+    WREN = 1;
+    if(valid)
+    {
+        param_mark(address, 0); // Invalidate the old record
+    }
+    PMADRL = (unsigned char)address;
+    PMADRH = (unsigned char)(address >> 8);
+    FREE = 1;                   // Erase the row
+    param_unlock();
+    FREE = 0;
+
+    LWLO = 1;                   // Load the write latches, one word at a time
+    for(unsigned char i = 0; i != PARAM_SIZE; i ++)
+    {
+        PMADRL = (unsigned char)address + i;
+        PMDATL = (i == 0) ? 0xFF : data[i];     // Version byte left erased
+        PMDATH = 0x3F;          // Leave the high bits erased
+        if(i == PARAM_SIZE - 1)
+        {
+            LWLO = 0;           // Write the row with the last word
+        }
+        param_unlock();
+    }
+    param_mark(address, PARAM_VERSION);     // Commit the new record
+    WREN = 0;
+    GIE = gie;
+
+    param_sequence = params->sequence;
+}
@@ -0,0 +1,93 @@
+/*==============================================================================
+ File: Params.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) High-Endurance Flash parameter store constant, type, and
+ function definitions.
+
+ High-Endurance Flash section:
+ The last 128 words of PIC16F1459 program memory (0x1F80-0x1FFF) are High-
+ Endurance Flash (HEF), whose low bytes withstand about 100,000 erase/write
+ cycles. The HEF is made up of four 32-word rows, and a row must be erased
+ before it is written. Reserve the HEF so that the linker does not place code
+ in it, by setting the linker ROM ranges to 'default,-0-7FF,-1F80-1FFF' under
+ the "Memory model" pull-down (the project file already does this).
+
+ Parameter records:
+ Each row holds one param_t record in the low bytes of its first PARAM_SIZE
+ words. A record starts with a PARAM_VERSION byte and an 8-bit sequence
+ number, and ends with a CRC-8 of all of the bytes before it. param_save()
+ writes each new record to the row after the newest record, so successive
+ saves are spread evenly over all four rows (wear levelling), and the
+ previous record stays intact until the new one has been completely written.
+ param_save() clears the version byte of the oldest record before erasing its
+ row, and writes the version byte of the new record only after the rest of
+ the record, so if power fails during a save the damaged row has no valid
+ version byte and param_load() falls back to the previous record. The CRC
+ check catches records damaged in any other way. The PARAM_VERSION byte
+ holds the record layout number, PARAM_LAYOUT, in its upper four bits, and the
+ number of calibrated sensors (which changes the record size when
+ SENSOR_ARRAY is defined) in its lower four bits, so a change to either one
+ never gives the same version. Increment PARAM_LAYOUT whenever param_t
+ changes, so that records in the old format are ignored.
+
+ Loading and saving time:
+ param_load() reads the version and sequence bytes of the four rows, and then
+ checks the CRC of the newest record, taking a few hundred microseconds.
+ param_save() stalls the CPU with interrupts off for a row erase and up to
+ three row writes (about 2 ms each), so it should not be called while line
+ following.
+ The PWM hardware keeps driving the motors during the stall.
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the Params.c
+ file.
+==============================================================================*/
+
+// Parameter store definitions
+#define PARAM_HEF       0x1F80      // First HEF row address
+#define PARAM_ROWS      4           // Number of HEF rows
+#define PARAM_ROW_SIZE  32          // Words per HEF row
+#define PARAM_LAYOUT    0x0C        // Record layout number (0-15)
+#define PARAM_VERSION   ((PARAM_LAYOUT << 4) | CAL_SENSORS) // Record version
+#define PARAM_SIZE      (sizeof(param_t))   // Record size in bytes (<= 32)
+
+// Parameter record type
+typedef struct
+{
+    unsigned char version;          // Record format version (PARAM_VERSION)
+    unsigned char sequence;         // Incremented by each save
+    unsigned char cal_min[CAL_SENSORS]; // Calibrated lightest sensor levels
+    unsigned char cal_max[CAL_SENSORS]; // Calibrated darkest sensor levels
+    unsigned char cal_curve;        // Sensor normalization curve
+    unsigned char kp;               // PID gains (Q4.4)
+    unsigned char ki;
+    unsigned char kd;
+    unsigned char base;             // Analog mode base speed
+    signed char trim;               // Motor balance trim (+ = steer right)
+    unsigned char mode;             // Last selected line-following mode
+    unsigned char threshold;        // Comparator DAC threshold
+    unsigned char crc;              // CRC-8 of all of the bytes above
+} param_t;
+
+// Prototypes for Params.c functions:
+
+/**
+ * Function: bool param_load(param_t *params)
+ *
+ * Copy the newest valid parameter record from HEF into 'params'. Returns
+ * false, leaving 'params' unchanged, if there is no valid record.
+ *
+ * Example usage: if(param_load(&params))
+ */
+bool param_load(param_t *);
+
+/**
+ * Function: void param_save(param_t *params)
+ *
+ * Write 'params' to the next HEF row as the newest record, setting its
+ * version, sequence number, and CRC.
+ *
+ * Example usage: param_save(&params);
+ */
+void param_save(param_t *);
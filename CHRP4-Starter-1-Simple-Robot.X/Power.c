@@ -0,0 +1,109 @@
+/*==============================================================================
+ File: Power.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) clock profile and sleep functions
+
+ Functions to switch between clock profiles while keeping the scheduler, PWM,
+ and EUSART timing consistent, and to park the robot in Sleep until a
+ pushbutton is pressed. Include the Power.h file in your main program to call
+ these functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "CHRP4.h"           // Include CHRP4 constant & function definitions
+#include    "Scheduler.h"       // Include scheduler timing definitions
+#include    "Telemetry.h"       // Include telemetry baud rate definition
+#include    "Power.h"           // Include power constant & function definitions
+
+unsigned char power_profile = POWER_48MHZ;  // Current clock profile
+
+// Clock profile settings, indexed by profile
+const unsigned char power_osccon[POWER_PROFILES] = {
+    0xFC,                       // 16 MHz HFINTOSC, 3x PLL, clock set by config
+    0b00111110,                 // 16 MHz HFINTOSC, internal oscillator block
+    0b00011110                  // 500 kHz MFINTOSC, internal oscillator block
+};
+const unsigned char power_option[POWER_PROFILES] = {
+    SCHED_PS,                   // TMR0 1:32 prescaler (2.67 us counts)
+    SCHED_PS,                   // TMR0 1:32 prescaler (8 us counts)
+    0b00001000                  // TMR0 prescaler bypassed (8 us counts)
+};
+const unsigned char power_scale[POWER_PROFILES] = {1, 3, 3};
+const unsigned char power_t2con[POWER_PROFILES] = {
+    0b00000110,                 // Timer2 on, 1:16 prescaler (2.94 kHz PWM)
+    0b00000101,                 // Timer2 on, 1:4 prescaler (3.92 kHz PWM)
+    0b00000100                  // Timer2 on, 1:1 prescaler (490 Hz PWM)
+};
+const unsigned char power_spbrg[POWER_PROFILES] = {
+    TELEMETRY_SPBRG,            // 115385 baud
+    34,                         // 114286 baud
+    0                           // No usable baud rate
+};
+
+// Switch clock profiles and re-time the clock-dependent peripherals.
+void power_clock(unsigned char profile)
+{
+    unsigned char gie = GIE;
+
+    OSCCON = power_osccon[profile];
+#ifndef SIMULATION
+    if(profile == POWER_48MHZ)
+    {
+        while(!PLLRDY);         // Wait for PLL lock
+    }
+    else if(profile == POWER_16MHZ)
+    {
+        while(!HFIOFS);         // Wait for stable HFINTOSC
+    }
+    else
+    {
+        while(!MFIOFR);         // Wait for MFINTOSC
+    }
+#endif
+
+    GIE = 0;                    // Change the tick rate and scale together
+    OPTION_REG = (OPTION_REG & 0b11110000) | power_option[profile];
+    sched_scale = power_scale[profile];
+    GIE = gie;
+
+    T2CON = power_t2con[profile];
+    if(TXEN && power_spbrg[profile] != 0)
+    {
+        SPBRGL = power_spbrg[profile];
+    }
+    power_profile = profile;
+}
+
+// Sleep until a pushbutton press changes one of the pushbutton inputs.
+void power_sleep(void)
+{
+    unsigned char intcon = INTCON;
+    unsigned char pie1 = PIE1;
+    unsigned char pie2 = PIE2;
+    unsigned char iocan = IOCAN;
+    unsigned char iocbn = IOCBN;
+
+    INTCON = 0;                 // Disable interrupts (wake without the isr)
+    PIE1 = 0;
+    PIE2 = 0;
+    IOCAN = iocan | 0b00001000; // Wake on SW1 (RA3) or SW2-SW5 (RB4-RB7)
+    IOCBN = iocbn | 0b11110000; // falling edges
+    IOCAF = 0;
+    IOCBF = 0;
+    IOCIE = 1;
+
+    SLEEP();
+    NOP();
+
+    IOCAN = iocan;
+    IOCBN = iocbn;
+    IOCAF = 0;
+    IOCBF = 0;
+    PIE1 = pie1;
+    PIE2 = pie2;
+    INTCON = intcon & 0b11111000;   // Restore enables, not interrupt flags
+}
@@ -0,0 +1,71 @@
+/*==============================================================================
+ File: Power.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) clock profile and sleep constant and function
+ definitions.
+
+ Clock profiles section:
+ power_clock() switches the CPU between three clock profiles. Every clock
+ rate-dependent setting is changed with the clock, so scheduler timing stays
+ the same at every profile:
+
+   Profile        Clock      TMR0 count  Ticks/overflow  PWM freq.  Baud rate
+   POWER_48MHZ    48 MHz     2.67 us     1               2.94 kHz   115385
+   POWER_16MHZ    16 MHz     8 us        3               3.92 kHz   114286
+   POWER_500KHZ   500 kHz    8 us        3               490 Hz     -
+
+ POWER_48MHZ uses the 16 MHz HFINTOSC with the 3x PLL (the oscillator setting
+ used by the bootloader), and is used for line following. POWER_16MHZ runs
+ directly from the HFINTOSC and uses about a third of the CPU current, which
+ is ample for the mode selector. POWER_500KHZ runs from the MFINTOSC and allows
+ only about 250 instruction cycles per TMR0 overflow, so it is only suited to
+ very small waiting loops, such as the mode selector once it has been left
+ idle for a few seconds. The ADC is too slow (TAD = 128 us) and telemetry is
+ unavailable at 500 kHz. The XC8 __delay_ms() and __delay_us() macros are
+ calculated for 48 MHz (_XTAL_FREQ in CHRP4.h), and take 3 or 96 times longer
+ at the slower profiles, so timed code should use scheduler ticks instead, or
+ switch to POWER_48MHZ first. Timer1 always counts instruction cycles.
+
+ Sleep section:
+ The PIC16F1459 has no idle or doze mode, and Timer0, Timer2 (PWM), and the
+ Timer2-triggered ADC scan all stop during Sleep, so the CPU cannot sleep
+ between scheduler ticks while the robot is running. power_sleep() instead
+ parks the robot: it sleeps until a pushbutton is pressed, waking from the
+ pushbutton interrupt-on-change inputs with all other interrupts disabled.
+ The sleep current is a few microamps, plus any LEDs left on.
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the Power.c file.
+==============================================================================*/
+
+// Clock profile definitions
+#define POWER_48MHZ     0           // 48 MHz HFINTOSC x3 PLL (full speed)
+#define POWER_16MHZ     1           // 16 MHz HFINTOSC (reduced power)
+#define POWER_500KHZ    2           // 500 kHz MFINTOSC (low power waiting)
+#define POWER_PROFILES  3
+
+// Current clock profile
+extern unsigned char power_profile;
+
+// Prototypes for Power.c functions:
+
+/**
+ * Function: void power_clock(unsigned char profile)
+ *
+ * Switch to a clock profile, and update the Timer0 prescaler and scheduler
+ * tick scale, Timer2 PWM prescaler, and EUSART baud rate to match. Call after
+ * sched_start(), motor_config(), and telemetry_config(), which all configure
+ * their peripherals for 48 MHz.
+ *
+ * Example usage: power_clock(POWER_16MHZ);
+ */
+void power_clock(unsigned char);
+
+/**
+ * Function: void power_sleep(void)
+ *
+ * Sleep until one of the pushbuttons SW1-SW5 is pressed. The pushbuttons must
+ * not be in use as TRIG, ECHO, IRIN, or TX pins.
+ */
+void power_sleep(void);
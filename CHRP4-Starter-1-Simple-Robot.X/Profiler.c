@@ -0,0 +1,163 @@
+/*==============================================================================
+ File: Profiler.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) hot-path cycle profiler functions
+
+ Functions to fold the times latched by the profiling macros in Profiler.h into
+ per-region execution time statistics and a control loop period histogram
+ outside of the measured code, and to report them
+ through the telemetry stream. These functions are only compiled when PROFILE
+ is defined. Include the Profiler.h file in your main program to use them.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "Profiler.h"        // Include profiler macro & function definitions
+#include    "Telemetry.h"       // Include telemetry functions for reports
+#include    "Scheduler.h"       // Include scheduler load statistics
+#include    "Power.h"           // Include clock profile
+
+#ifdef PROFILE
+
+unsigned char prof_h;                       // Probe TMR1H copy
+unsigned int prof_start[PROF_REGIONS];      // Region start timestamps
+unsigned int prof_end[PROF_REGIONS];        // Region end timestamps
+unsigned int prof_pass;                     // Loop pass timestamp
+unsigned char prof_ready;                   // Ended regions and loop pass
+unsigned int prof_min[PROF_REGIONS];        // Shortest region time (cycles)
+unsigned int prof_max[PROF_REGIONS];        // Longest region time (cycles)
+unsigned long prof_total[PROF_REGIONS];     // Total region time (cycles)
+unsigned int prof_count[PROF_REGIONS];      // Region run count
+unsigned int prof_hist[PROF_BINS];          // Loop period histogram
+unsigned int prof_last;                     // Previous loop pass timestamp
+unsigned char prof_next;                    // Next statistic to report
+
+// Clear all statistics.
+void prof_reset(void)
+{
+    for(unsigned char r = 0; r != PROF_REGIONS; r ++)
+    {
+        prof_min[r] = 0xFFFF;
+        prof_max[r] = 0;
+        prof_total[r] = 0;
+        prof_count[r] = 0;
+    }
+    for(unsigned char b = 0; b != PROF_BINS; b ++)
+    {
+        prof_hist[b] = 0;
+    }
+    prof_ready = 0;
+    prof_next = 0;
+}
+
+// Add one region time, less the probe overhead, to the region statistics.
+// Statistics stop accumulating once the run count reaches 65535, so the mean
+// remains valid.
+void prof_record(unsigned char region)
+{
+    unsigned int time = prof_end[region] - prof_start[region];
+
+    if(prof_count[region] == 0xFFFF)
+    {
+        return;
+    }
+    time = (time > PROF_OVERHEAD) ? time - PROF_OVERHEAD : 0;
+    prof_count[region] ++;
+    prof_total[region] += time;
+    if(time < prof_min[region])
+    {
+        prof_min[region] = time;
+    }
+    if(time > prof_max[region])
+    {
+        prof_max[region] = time;
+    }
+}
+
+// Count the loop period in the histogram bin of its highest set bit.
+void prof_loop(void)
+{
+    unsigned int period = prof_pass - prof_last;
+    unsigned char bin = 0;
+
+    prof_last = prof_pass;
+    while(period > 1)
+    {
+        period >>= 1;
+        bin ++;
+    }
+    if(prof_hist[bin] != 0xFFFF)
+    {
+        prof_hist[bin] ++;
+    }
+}
+
+// Fold the latched region times and loop pass into the statistics.
+void prof_fold(void)
+{
+    unsigned char ready = prof_ready;
+
+    prof_ready = 0;
+    for(unsigned char r = 0; r != PROF_REGIONS; r ++)
+    {
+        if(ready & (1 << r))
+        {
+            prof_record(r);
+        }
+    }
+    if(ready & PROF_LOOP_BIT)
+    {
+        prof_loop();
+    }
+}
+
+// Send the next statistics frame: one frame for each region, followed by one
+// frame for each group of three histogram bins and a scheduler frame.
+void prof_report(void)
+{
+    unsigned char r = prof_next;
+    unsigned int mean = 0;
+    unsigned char bin;
+
+    if(r < PROF_REGIONS)
+    {
+        if(prof_count[r] != 0)
+        {
+            mean = (unsigned int)(prof_total[r] / prof_count[r]);
+        }
+        if(!telemetry_stats(r, prof_min[r], prof_max[r], mean,
+                            prof_count[r] > 255 ? 255 : (unsigned char)prof_count[r]))
+        {
+            return;             // Try again next time
+        }
+    }
+    else if(r == PROF_REGIONS + (PROF_BINS + 2) / 3)
+    {
+        if(!telemetry_stats(PROF_SCHED_ID, sched_load, sched_slips,
+                            power_profile, 0))
+        {
+            return;
+        }
+    }
+    else
+    {
+        bin = (r - PROF_REGIONS) * 3;
+        if(!telemetry_stats(PROF_HIST_ID + (r - PROF_REGIONS), prof_hist[bin],
+                            bin + 1 < PROF_BINS ? prof_hist[bin + 1] : 0,
+                            bin + 2 < PROF_BINS ? prof_hist[bin + 2] : 0, 0))
+        {
+            return;
+        }
+    }
+
+    prof_next ++;
+    if(prof_next > PROF_REGIONS + (PROF_BINS + 2) / 3)
+    {
+        prof_next = 0;
+    }
+}
+
+#endif
@@ -0,0 +1,123 @@
+/*==============================================================================
+ File: Profiler.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) hot-path cycle profiler macro and function definitions.
+
+ Profiler enable section:
+ Profiling code is only compiled when PROFILE is defined, either by removing
+ the comment from the definition below or by adding PROFILE to the project's
+ XC8 compiler 'Define macros' setting. When PROFILE is not defined, all of the
+ profiling macros are empty and the profiler uses no code or data memory.
+
+ Profiling macros section:
+ PROFILE_START(region) and PROFILE_END(region) surround a region of code and
+ measure its execution time in instruction cycles using Timer1 (configured by
+ TMR1_config as a free-running FOSC/4 counter). Each probe reads TMR1 high
+ byte first, then the low byte, and re-reads if the high byte changed, which
+ takes 8 instruction cycles when no roll-over occurs. PROFILE_START stores
+ the start time of its region, and PROFILE_END only latches the end time and
+ sets the region's bit in prof_ready (a single bsf instruction, since the
+ region is a constant), so neither probe calls a function or does any
+ arithmetic inside the code being measured.
+
+ PROFILE_LOOP() is placed once in a control loop. It latches the time of each
+ pass in the same way, and the period between passes is counted in a log2
+ histogram, where bin n counts periods of 2^n to 2^(n+1)-1 cycles (bin 13, for
+ example, holds 8192-16383 cycles, or 683-1365 us).
+
+ Statistics folding:
+ prof_fold() runs as the last task of each scheduler task table, after every
+ profiled region in the same tick, so each region's latched end time is folded
+ in before its next start. It adds the time of each region that has ended
+ since its last call to the region's minimum, maximum, and total cycle counts
+ and its run count, and counts the loop period in the histogram. A region
+ that runs more than once between calls only has its last run counted. The
+ probes themselves still add the cycles from the start probe's TMR1L read to
+ the end of that probe, and from the start of the end probe to its TMR1L
+ read -- 8 cycles for an empty region -- and prof_fold() subtracts this
+ PROF_OVERHEAD from every region time. Region times must be less than 65536
+ cycles (5.46 ms).
+
+ Statistics reporting:
+ prof_report() sends one statistics frame each time it is called through the
+ telemetry stream (see Telemetry.h), cycling through one frame per region and
+ then the histogram, and then the scheduler. Region frames have the region
+ number as their ID, and hold the minimum, maximum, and mean cycle counts and
+ the run count (limited to 255). Histogram frames have an ID of PROF_HIST_ID
+ plus n, and hold the counts of bins 3n, 3n+1, and 3n+2. The scheduler frame
+ has an ID of PROF_SCHED_ID, and holds the scheduler load (sched_load, see
+ Scheduler.h), the tick slip count, and the clock profile (see Power.h).
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the Profiler.c
+ file.
+==============================================================================*/
+
+// Profiler enable definition
+//#define PROFILE
+
+// Profiler definitions
+#define PROF_REGIONS    4           // Number of profiled code regions
+#define PROF_BINS       16          // Loop period histogram bins (log2 cycles)
+#define PROF_HIST_ID    0x80        // First histogram statistics frame ID
+#define PROF_SCHED_ID   0x40        // Scheduler statistics frame ID
+#define PROF_OVERHEAD   8           // Probe cycles in an empty region
+#define PROF_LOOP_BIT   (1 << PROF_REGIONS) // prof_ready loop pass bit
+
+#ifdef PROFILE
+
+// Profiler probe data
+extern unsigned char prof_h;                    // Probe TMR1H copy
+extern unsigned int prof_start[PROF_REGIONS];   // Region start timestamps
+extern unsigned int prof_end[PROF_REGIONS];     // Region end timestamps
+extern unsigned int prof_pass;                  // Loop pass timestamp
+extern unsigned char prof_ready;                // Ended regions and loop pass
+
+// Read TMR1 into t, high byte first, re-reading if the low byte rolled over
+#define PROF_TIME(t)        do { prof_h = TMR1H; \
+                                 (t) = ((unsigned int)prof_h << 8) | TMR1L; \
+                            } while(prof_h != TMR1H)
+
+// Profiling macros
+#define PROFILE_START(r)    PROF_TIME(prof_start[(r)])
+#define PROFILE_END(r)      do { PROF_TIME(prof_end[(r)]); \
+                                 prof_ready |= 1 << (r); } while(0)
+#define PROFILE_LOOP()      do { PROF_TIME(prof_pass); \
+                                 prof_ready |= PROF_LOOP_BIT; } while(0)
+
+// Prototypes for Profiler.c functions:
+
+/**
+ * Function: void prof_reset(void)
+ *
+ * Clear all region statistics and the loop period histogram.
+ */
+void prof_reset(void);
+
+/**
+ * Function: void prof_fold(void)
+ *
+ * Add the latched time of each region that has ended, less PROF_OVERHEAD, to
+ * its statistics, and the latched loop pass period to the loop period
+ * histogram. Run as the last task of each scheduler task table.
+ *
+ * Example usage: {prof_fold, 1, 16},
+ */
+void prof_fold(void);
+
+/**
+ * Function: void prof_report(void)
+ *
+ * Send the next region or histogram statistics frame to the telemetry stream.
+ */
+void prof_report(void);
+
+#else
+
+// Profiling macros (profiling disabled)
+#define PROFILE_START(r)
+#define PROFILE_END(r)
+#define PROFILE_LOOP()
+
+#endif
@@ -0,0 +1,151 @@
+/*==============================================================================
+ File: Remote.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) IR remote control decoder functions
+
+ Interrupt-on-change NEC remote decoder for the IR demodulator on IRIN (RB7),
+ timed by the Timer0 tick scheduler. These functions are only compiled when
+ REMOTE is defined. Include the Remote.h file in your main program to call
+ these functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "CHRP4.h"           // Include CHRP4 constant & function definitions
+#include    "Scheduler.h"       // Include scheduler time base functions
+#include    "Profiler.h"        // Include profiler enable definition
+#include    "Remote.h"          // Include remote constant & function definitions
+
+#ifdef REMOTE
+
+#define REMOTE_IDLE     0xFF        // Bit count while waiting for a leader
+
+unsigned int remote_last;           // Previous falling edge timestamp
+unsigned char remote_bits = REMOTE_IDLE;    // Data bits received
+unsigned long remote_data;          // Data bits, shifted in from the top
+bool remote_held;                   // A repeat code may follow
+volatile unsigned char remote_command;  // Last received command
+volatile bool remote_ready;         // remote_command is new
+
+#ifdef PROFILE
+unsigned int remote_isr_worst;      // Longest remote_isr() time (cycles)
+
+// Read Timer1 (see Profiler.h). The profiler's own probe variables are used
+// by the main program, so the interrupt handler uses this separate copy.
+unsigned int remote_cycles(void)
+{
+    unsigned char h;
+    unsigned int t;
+
+    do
+    {
+        h = TMR1H;
+        t = ((unsigned int)h << 8) | TMR1L;
+    } while(h != TMR1H);
+    return (t);
+}
+#endif
+
+// Enable falling edge interrupts on IRIN.
+void remote_start(void)
+{
+    remote_bits = REMOTE_IDLE;
+    remote_held = false;
+    remote_ready = false;
+    IOCBN = IOCBN | REMOTE_IOC; // Interrupt at the start of each IR burst
+    IOCBF7 = 0;
+    IOCIE = 1;                  // Enable interrupt-on-change
+}
+
+// Decode the time since the previous falling edge.
+void remote_edge(void)
+{
+    unsigned int now = sched_isr_time();
+    unsigned int gap = now - remote_last;
+    unsigned char command;
+
+    remote_last = now;
+    if(gap > REMOTE_LEADER_MIN && gap < REMOTE_LEADER_MAX)
+    {
+        remote_bits = 0;        // Leader - start a new frame
+        return;
+    }
+    if(gap > REMOTE_REPEAT_MIN && gap < REMOTE_REPEAT_MAX)
+    {
+        if(remote_held)         // Repeat code - resend the last command
+        {
+            remote_ready = true;
+        }
+        remote_bits = REMOTE_IDLE;
+        return;
+    }
+    if(gap > REMOTE_HOLD_MAX)
+    {
+        remote_held = false;    // Key was released
+    }
+    if(remote_bits == REMOTE_IDLE)
+    {
+        return;                 // Gap between frames
+    }
+    if(gap < REMOTE_BIT_MIN || gap > REMOTE_BIT_MAX)
+    {
+        remote_bits = REMOTE_IDLE;  // Not a valid bit - wait for a new leader
+        remote_held = false;
+        return;
+    }
+
+    remote_data >>= 1;
+    if(gap > REMOTE_BIT_SPLIT)
+    {
+        remote_data |= 0x80000000;
+    }
+    remote_bits ++;
+    if(remote_bits == 32)
+    {
+        command = (unsigned char)(remote_data >> 16);
+        if((command ^ (unsigned char)(remote_data >> 24)) == 0xFF)
+        {
+            remote_command = command;
+            remote_ready = true;
+            remote_held = true;
+        }
+        remote_bits = REMOTE_IDLE;
+    }
+}
+
+// Handle an IRIN falling edge, measuring the handler time if profiling.
+void remote_isr(void)
+{
+#ifdef PROFILE
+    unsigned int start = remote_cycles();
+    unsigned int time;
+#endif
+
+    IOCBF7 = 0;
+    remote_edge();
+
+#ifdef PROFILE
+    time = remote_cycles() - start;
+    if(time > remote_isr_worst)
+    {
+        remote_isr_worst = time;
+    }
+#endif
+}
+
+// Return the newest command, if one has arrived since the last call.
+bool remote_read(unsigned char *command)
+{
+    if(!remote_ready)
+    {
+        return (false);
+    }
+    remote_ready = false;       // Clear first, so a new command is not lost
+    *command = remote_command;
+    return (true);
+}
+
+#endif
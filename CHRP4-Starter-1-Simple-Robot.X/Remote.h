@@ -0,0 +1,94 @@
+/*==============================================================================
+ File: Remote.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) IR remote control decoder constant and function
+ definitions.
+
+ IR remote enable section:
+ The IR demodulator output, IRIN, shares RB7 (header H4) with SW5 and the
+ EUSART TX pin used by the telemetry stream, so the remote decoder and
+ telemetry cannot be used at the same time. Remote decoding code is only
+ compiled when REMOTE is defined, either by removing the comment from the
+ definition below or by adding REMOTE to the project's XC8 compiler 'Define
+ macros' setting. Telemetry output is not started when REMOTE is defined.
+
+ NEC remote protocol:
+ NEC remotes send a 9 ms carrier burst and a 4.5 ms space, followed by 32 data
+ bits (address, inverted address, command, inverted command, least significant
+ bit first) and a final burst. Each bit is a 562 us burst followed by a 562 us
+ (0) or 1687 us (1) space. Holding a key down sends a repeat code -- a 9 ms
+ burst, a 2.25 ms space, and a final burst -- every 108 ms. The demodulator
+ output is low during each burst.
+
+ Decoding:
+ The RB7 interrupt-on-change handler, remote_isr(), runs only on falling edges
+ (the start of each burst) and timestamps them using the scheduler's tick:TMR0
+ time base (2.67 us per count). The time between falling edges identifies the
+ leader (13.5 ms), repeat code (11.25 ms), and each 0 (1.125 ms) or 1 (2.25
+ ms) bit, so each edge needs only a subtraction and a few comparisons, and the
+ decoder never polls the input. Commands with a valid inverted copy, and
+ repeat codes received within 120 ms of the previous frame, are passed to the
+ main program through remote_read().
+
+ Decoder interrupt time:
+ The decoder runs at most once every 1.125 ms (less than once per scheduler
+ tick). When PROFILE is also defined, the longest remote_isr() time in
+ instruction cycles is kept in remote_isr_worst, which can be viewed in the
+ debugger's watch window (the telemetry stream is not available).
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the Remote.c
+ file.
+==============================================================================*/
+
+// IR remote enable definition
+//#define REMOTE
+
+// NEC remote timing definitions (TMR0 counts of 2.67 us between falling edges)
+#define REMOTE_BIT_MIN      300     // Shortest bit (0 bit is 422)
+#define REMOTE_BIT_SPLIT    633     // Longer bits are 1 bits (1 bit is 844)
+#define REMOTE_BIT_MAX      1100    // Longest bit
+#define REMOTE_REPEAT_MIN   3800    // Repeat code (4219)
+#define REMOTE_REPEAT_MAX   4600
+#define REMOTE_LEADER_MIN   4700    // Leader (5063)
+#define REMOTE_LEADER_MAX   5500
+#define REMOTE_HOLD_MAX     45000   // Longest gap before a repeat (120 ms)
+#define REMOTE_IOC          0b10000000  // IRIN (RB7) interrupt-on-change bit
+
+#ifdef REMOTE
+
+#ifdef PROFILE
+extern unsigned int remote_isr_worst;   // Longest remote_isr() time (cycles)
+#endif
+
+// Prototypes for Remote.c functions:
+
+/**
+ * Function: void remote_start(void)
+ *
+ * Enable interrupt-on-change on the falling edges of IRIN (RB7) and start
+ * decoding NEC remote frames.
+ */
+void remote_start(void);
+
+/**
+ * Function: void remote_isr(void)
+ *
+ * IRIN (RB7) interrupt-on-change handler. Timestamps each falling edge and
+ * decodes the time since the previous edge.
+ */
+void remote_isr(void);
+
+/**
+ * Function: bool remote_read(unsigned char *command)
+ *
+ * Copy the most recently received remote command into 'command' and return
+ * true, or return false if no new command or repeat code has been received
+ * since the last call.
+ *
+ * Example usage: if(remote_read(&key))
+ */
+bool remote_read(unsigned char *);
+
+#endif
@@ -0,0 +1,152 @@
+/*==============================================================================
+ File: Scheduler.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) Timer0 tick scheduler functions
+
+ A small cooperative scheduler driven by the Timer0 overflow interrupt. The
+ main program describes its work as a table of tasks, each with a fixed period
+ and execution time budget, and calls sched_run() from its main loop. Every
+ tick, the scheduler runs the tasks that are due and records how long each one
+ took, how late it started, and how often it overran its budget. Include the
+ Scheduler.h file in your main program to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "CHRP4.h"           // Include CHRP4 constant & function definitions
+#include    "Scheduler.h"       // Include scheduler constant & function definitions
+
+volatile unsigned char sched_ticks; // Tick counter, incremented by sched_isr()
+unsigned char sched_now;        // Tick most recently processed by sched_run()
+unsigned char sched_slips;      // Ticks skipped because tasks overran a tick
+unsigned char sched_load;       // Active duty cycle (255 = 100%)
+unsigned char sched_scale = 1;  // Ticks per TMR0 overflow
+unsigned int sched_idle;        // Time spent waiting for ticks (TMR0 counts)
+unsigned char sched_window;     // Tick at the start of the load measurement
+
+// Set the TMR0 prescaler for the scheduler tick and enable its interrupt.
+void sched_start(void)
+{
+    TMR0IE = 0;
+    OPTION_REG = (OPTION_REG & 0b11111000) | SCHED_PS;  // Set TMR0 prescaler
+    TMR0 = 0;
+    sched_ticks = 0;
+    sched_now = 0;
+    TMR0IF = 0;
+    TMR0IE = 1;                 // Enable Timer0 overflow interrupt
+}
+
+// Timer0 interrupt handler - count the scheduler tick.
+void sched_isr(void)
+{
+    TMR0IF = 0;
+    sched_ticks += sched_scale;
+}
+
+// Return the tick:TMR0 timestamp, re-reading TMR0 if a tick occurs during the
+// read so that the two halves always belong together. At slow clock profiles
+// each TMR0 count is 3 scheduler time units.
+unsigned int sched_time(void)
+{
+    unsigned char ticks;
+    unsigned char count;
+
+    do
+    {
+        ticks = sched_ticks;
+        count = TMR0;
+    } while(ticks != sched_ticks);
+    if(sched_scale != 1)
+    {
+        return (((unsigned int)ticks << 8) + ((unsigned int)count << 1) + count);
+    }
+    return (((unsigned int)ticks << 8) | count);
+}
+
+// Return the tick:TMR0 timestamp from an interrupt handler. Interrupts are off,
+// so sched_ticks cannot change, but TMR0 may have overflowed since sched_isr()
+// last ran. A small TMR0 count with TMR0IF set belongs to the next tick.
+unsigned int sched_isr_time(void)
+{
+    unsigned char ticks = sched_ticks;
+    unsigned char count = TMR0;
+
+    if(TMR0IF && count < 128)
+    {
+        ticks += sched_scale;
+    }
+    if(sched_scale != 1)
+    {
+        return (((unsigned int)ticks << 8) + ((unsigned int)count << 1) + count);
+    }
+    return (((unsigned int)ticks << 8) | count);
+}
+
+// Wait for the next tick, and then run and measure all of the tasks that are
+// due. Tasks run in table order, so the start jitter of each task includes the
+// execution time of the tasks before it in the same tick.
+void sched_run(sched_task_t *tasks, unsigned char count)
+{
+    unsigned char elapsed;
+    unsigned int start;
+    unsigned int time;
+
+    start = sched_time();
+    while(sched_ticks == sched_now) // Wait for the next tick
+    {
+        NOP();                  // About 6 cycles (0.5 us) per pass with XC8:
+                                // NOP, load, compare, skip and GOTO
+    }
+    sched_idle += sched_time() - start;
+    elapsed = sched_ticks - sched_now;
+    sched_now += elapsed;
+    if(elapsed > sched_scale)
+    {
+        sched_slips += elapsed - sched_scale;   // Count ticks lost to overruns
+    }
+
+    // Update the load from the waiting time (SCHED_LOAD_TICKS ticks is 16384
+    // TMR0 counts, so idle / 64 is the idle fraction of 256)
+    if((unsigned char)(sched_now - sched_window) >= SCHED_LOAD_TICKS)
+    {
+        sched_window = sched_now;
+        time = sched_idle >> 6;
+        sched_load = (time > 255) ? 0 : 255 - (unsigned char)time;
+        sched_idle = 0;
+    }
+
+    for(sched_task_t *task = tasks; task != tasks + count; task ++)
+    {
+        if(task->due > elapsed)
+        {
+            task->due -= elapsed;   // Not due yet
+            continue;
+        }
+        if(task->due != 0 && task->due + sched_scale <= elapsed)
+        {
+            task->overruns ++;      // Release was missed during a skipped tick
+        }
+        task->due = task->period;
+
+        start = sched_time();
+        task->run();
+        time = sched_time() - start;
+
+        if(time > task->worst)
+        {
+            task->worst = time;
+        }
+        if(time > task->budget)
+        {
+            task->overruns ++;
+        }
+        time = start - ((unsigned int)sched_now << 8);  // Delay after release
+        if(time > task->jitter)
+        {
+            task->jitter = time;
+        }
+    }
+}
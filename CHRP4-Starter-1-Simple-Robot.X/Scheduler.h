@@ -0,0 +1,112 @@
+/*==============================================================================
+ File: Scheduler.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) Timer0 tick scheduler constant, type, and function
+ definitions.
+
+ Scheduler timing definitions section:
+ Timer0 is clocked from FOSC/4 (12 MHz) through a 1:32 prescaler, so each TMR0
+ count is 32 instruction cycles (2.67 us) and each TMR0 overflow -- one
+ scheduler tick -- is 256 counts, or 682.7 us (1465 Hz). Task execution times,
+ budgets, and release jitter are all measured in TMR0 counts.
+
+ At the slower clock profiles selected by power_clock() (see Power.h), each
+ TMR0 count is three times longer (8 us), and each TMR0 overflow is counted as
+ sched_scale (3) ticks, so tick periods and timestamps keep the same 683 us and
+ 2.67 us units at every clock speed. Tasks then run at most once per overflow
+ (2.05 ms), so tasks with shorter periods run less often.
+
+ Scheduler load section:
+ sched_run() measures how long it waits for each tick. Every SCHED_LOAD_TICKS
+ ticks it updates sched_load, the fraction of time spent running tasks rather
+ than waiting (0-255, where 255 is fully busy). Interrupts that occur while
+ waiting are counted as waiting time. This active duty cycle is the main
+ factor in the CPU's share of the supply current.
+
+ Task type section:
+ Each task is a function that is run every 'period' ticks and is expected to
+ finish within 'budget' TMR0 counts. The remaining members are maintained by
+ the scheduler and record the task's worst-case execution time, worst-case
+ start delay (jitter) after its release tick, and the number of overruns --
+ runs that took longer than the task's budget, or releases that were missed
+ because earlier tasks ran past the end of their tick. Initialize 'due' to 0
+ (or leave it out of the task table initializer) to run a task on the first
+ tick after the scheduler starts.
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the Scheduler.c
+ file.
+==============================================================================*/
+
+// Scheduler timing definitions
+#define SCHED_PS        0b00000100  // OPTION_REG TMR0 prescaler bits (1:32)
+#define SCHED_TICK_US   683         // Scheduler tick period in microseconds
+#define SCHED_COUNT_CY  32          // Instruction cycles per TMR0 count
+#define SCHED_LOAD_TICKS 64         // Ticks per sched_load measurement
+
+// Scheduler task type
+typedef struct
+{
+    void (*run)(void);          // Task function
+    unsigned char period;       // Task period (ticks)
+    unsigned char budget;       // Task execution time budget (TMR0 counts)
+    unsigned char due;          // Ticks remaining until next release
+    unsigned char overruns;     // Over-budget runs and missed releases
+    unsigned int worst;         // Worst-case execution time (TMR0 counts)
+    unsigned int jitter;        // Worst-case start delay (TMR0 counts)
+} sched_task_t;
+
+// Scheduler tick counters (read-only outside of Scheduler.c)
+extern volatile unsigned char sched_ticks;  // Advanced by each TMR0 overflow
+extern unsigned char sched_slips;           // Ticks skipped by overrunning tasks
+extern unsigned char sched_load;            // Active duty cycle (255 = 100%)
+
+// Ticks per TMR0 overflow (1, or 3 at slow clock profiles, set by Power.c)
+extern unsigned char sched_scale;
+
+// Prototypes for Scheduler.c functions:
+
+/**
+ * Function: void sched_start(void)
+ *
+ * Set the Timer0 prescaler for the scheduler tick rate and enable the Timer0
+ * overflow interrupt.
+ */
+void sched_start(void);
+
+/**
+ * Function: void sched_isr(void)
+ *
+ * Timer0 interrupt handler. Clears the interrupt flag and counts the tick
+ * (or sched_scale ticks).
+ */
+void sched_isr(void);
+
+/**
+ * Function: unsigned int sched_time(void)
+ *
+ * Return a 16-bit timestamp made up of the tick count (upper 8 bits) and the
+ * TMR0 count (lower 8 bits), in units of TMR0 counts.
+ */
+unsigned int sched_time(void);
+
+/**
+ * Function: unsigned int sched_isr_time(void)
+ *
+ * Return the same timestamp as sched_time(), for use inside interrupt
+ * handlers. Counts a Timer0 overflow that is still waiting for sched_isr().
+ */
+unsigned int sched_isr_time(void);
+
+/**
+ * Function: void sched_run(sched_task_t *tasks, unsigned char count)
+ *
+ * Wait for the next scheduler tick, then run each task in the task table that
+ * is due in table order, measuring its execution time and start jitter, and
+ * the scheduler load. Call this function repeatedly from the main program
+ * loop.
+ *
+ * Example usage: sched_run(analogTasks, ANALOG_TASKS);
+ */
+void sched_run(sched_task_t *, unsigned char);
@@ -0,0 +1,112 @@
+/*==============================================================================
+ File: SensorArray.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) line sensor array functions
+
+ Functions to normalize the levels of a row of line sensors and find the line
+ position as a weighted centroid, with line lost detection. These functions
+ are only compiled when SENSOR_ARRAY is defined. Include the SensorArray.h file
+ in your main program to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "CHRP4.h"           // Include CHRP4 constant & function definitions
+#include    "Calibration.h"     // Include calibrated sensor ranges
+#include    "SensorArray.h"     // Include sensor array constant & function definitions
+
+#ifdef SENSOR_ARRAY
+
+// Scan list index of each sensor, from left to right
+#ifdef SENSOR_MUX
+const unsigned char array_order[ARRAY_SENSORS] = {4, 2, SCAN_Q1, SCAN_Q2, 3, 5};
+#else
+const unsigned char array_order[ARRAY_SENSORS] = {2, SCAN_Q1, SCAN_Q2, 3};
+#endif
+
+bool array_lost;                    // No sensor sees the line
+int array_last;                     // Last line position
+unsigned char array_low[ARRAY_SENSORS];     // Lightest raw levels
+unsigned char array_range[ARRAY_SENSORS];   // Raw light to dark ranges
+unsigned int array_scale[ARRAY_SENSORS];    // Normalization factors (Q8)
+
+// Make the scale factors that multiply raw levels above the lightest level up
+// to 0-255 darkness levels.
+void array_build(void)
+{
+    for(unsigned char s = 0; s != ARRAY_SENSORS; s ++)
+    {
+        array_low[s] = cal_min[s];
+        array_range[s] = cal_max[s] - cal_min[s];
+        if(cal_max[s] < cal_min[s] || array_range[s] < CAL_MIN_RANGE)
+        {
+            array_low[s] = 0;   // No usable sweep - use a 1:1 mapping
+            array_range[s] = 255;
+        }
+        array_scale[s] = 65280 / array_range[s];    // 255 x 256 / range
+    }
+    array_lost = false;
+    array_last = 0;
+}
+
+// Sum the sensor weights (darkness above the background) and their moments
+// about the leftmost sensor, and divide to find the centroid.
+int array_position(unsigned char *levels)
+{
+    unsigned int sum = 0;
+    unsigned int moment = 0;
+    unsigned char s;
+    unsigned char level;
+    unsigned char weight;
+    int span;
+
+    for(unsigned char i = 0; i != ARRAY_SENSORS; i ++)
+    {
+        s = array_order[i];
+        level = 0;
+        if(levels[s] > array_low[s])
+        {
+            level = levels[s] - array_low[s];
+            if(level >= array_range[s])
+            {
+                level = 255;
+            }
+            else
+            {
+                level = (unsigned char)((level * array_scale[s]) >> 8);
+            }
+        }
+        if(level > ARRAY_FLOOR)
+        {
+            weight = level - ARRAY_FLOOR;
+            sum += weight;
+            moment += (unsigned int)weight * i;
+        }
+    }
+
+    if(sum < ARRAY_LOST)
+    {
+        array_lost = true;      // Head back towards the side the line left by
+        if(array_last > ARRAY_RANGE / 2)
+        {
+            array_last = ARRAY_RANGE;
+        }
+        else if(array_last < -ARRAY_RANGE / 2)
+        {
+            array_last = -ARRAY_RANGE;
+        }
+        return (array_last);
+    }
+
+    // Centroid c = moment / sum from 0 (left) to ARRAY_SENSORS - 1 (right),
+    // scaled to position = ARRAY_RANGE x (1 - 2c / (ARRAY_SENSORS - 1))
+    array_lost = false;
+    span = (int)((ARRAY_SENSORS - 1) * sum);
+    array_last = (int)((long)(span - (int)(moment * 2)) * ARRAY_RANGE / span);
+    return (array_last);
+}
+
+#endif
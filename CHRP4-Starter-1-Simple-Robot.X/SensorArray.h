@@ -0,0 +1,81 @@
+/*==============================================================================
+ File: SensorArray.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) line sensor array constant and function definitions.
+
+ Sensor array enable section:
+ Sensor array code is only compiled when SENSOR_ARRAY is defined, either by
+ removing the comment from its definition in CHRP4.h or by adding SENSOR_ARRAY
+ to the project's XC8 compiler 'Define macros' setting. Also define SENSOR_MUX
+ to use external analog multiplexers. The array is used in analog mode.
+
+ Sensor array connections:
+ The array adds line sensors on H1 (AN10) and H2 (AN11) outside of Q1 and Q2,
+ giving four sensors in a row: H1, Q1, Q2, H2 from left to right. With
+ SENSOR_MUX, H1 and H2 are the outputs of two 2-channel analog multiplexers
+ (e.g. a 74HC4053) whose select inputs are driven by H3, giving six sensors:
+ H1 input 1, H1 input 0, Q1, Q2, H2 input 0, H2 input 1. Space the sensors
+ evenly, and power their emitters from the D7 and D8 floor sensor LED outputs
+ so that synchronous sensing works for every sensor. H1 and H2 are shared with
+ SW2 and SW3 (and H3 with SW4), which stop being sampled once line following
+ starts, and SONAR and encoders cannot be used with the array. Change
+ array_order in SensorArray.c to match a different sensor layout.
+
+ Line position:
+ array_position() normalizes each sensor's raw level from its calibrated range
+ (cal_min and cal_max, see Calibration.h) to a 0-255 darkness level, using a
+ scale factor made by array_build() so that no division is needed per sensor.
+ Darkness up to ARRAY_FLOOR is treated as background, and the rest weights the
+ sensor's position in a weighted centroid (average position) of the line. The
+ centroid is interpolated between sensors, so the position changes smoothly as
+ the line moves across the array instead of in steps, and it is returned in
+ fixed point from ARRAY_RANGE (under the leftmost sensor) to -ARRAY_RANGE
+ (under the rightmost sensor). This matches the range and sign of the two-
+ sensor difference, so the PID gains carry over. The array costs about 40
+ instruction cycles per sensor plus one 32-bit division per update.
+
+ Line lost detection:
+ If the total weight of all of the sensors is less than ARRAY_LOST, no sensor
+ sees the line, and array_lost is set. The position is then held at the last
+ position, or pushed all the way to the side where the line was last seen if
+ it was already more than half way out, so the robot turns back towards the
+ line after overshooting a corner but drives straight across gaps.
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the
+ SensorArray.c file.
+==============================================================================*/
+
+// Sensor array definitions
+#define ARRAY_SENSORS   ADC_SCAN_COUNT  // Sensors in the array
+#define ARRAY_FLOOR     32          // Background darkness level (ignored)
+#define ARRAY_LOST      64          // Smallest total weight of a seen line
+#define ARRAY_RANGE     255         // Position under the outermost sensors
+
+#ifdef SENSOR_ARRAY
+
+extern bool array_lost;             // No sensor sees the line
+
+// Prototypes for SensorArray.c functions:
+
+/**
+ * Function: void array_build(void)
+ *
+ * Make each sensor's normalization scale factor from its calibrated range. Call
+ * after calibrating or restoring the calibration.
+ */
+void array_build(void);
+
+/**
+ * Function: int array_position(unsigned char *levels)
+ *
+ * Return the line position (ARRAY_RANGE = left, 0 = centre, -ARRAY_RANGE =
+ * right) from a set of raw sensor levels in ADC scan list order, and update
+ * array_lost.
+ *
+ * Example usage: steering = pid_update(array_position(lightLevels));
+ */
+int array_position(unsigned char *);
+
+#endif
@@ -23,14 +23,90 @@
 #include    "stdbool.h"         // Include Boolean (true/false) definitions
 
 #include    "CHRP4.h"           // Include CHRP4 constants and functions
+#include    "Motors.h"          // Include background motor drive functions
+#include    "Scheduler.h"       // Include Timer0 tick scheduler functions
+#include    "PID.h"             // Include PID line-following controller
+#include    "Calibration.h"     // Include light sensor calibration functions
+#include    "Telemetry.h"       // Include EUSART telemetry functions
+#include    "Profiler.h"        // Include cycle profiler macros
+#include    "Buttons.h"         // Include debounced pushbutton functions
+#include    "Sonar.h"           // Include SONAR ranging functions
+#include    "Remote.h"          // Include IR remote decoder functions
+#include    "Power.h"           // Include clock profile and sleep functions
+#include    "Params.h"          // Include HEF parameter store functions
+#include    "Track.h"           // Include lap-learning track log functions
+#include    "Encoders.h"        // Include wheel encoder odometry functions
+#include    "Comparators.h"     // Include comparator line-edge functions
+#include    "SensorArray.h"     // Include line sensor array functions
+#include    "BlackBox.h"        // Include black box recorder functions
 
-// TODO Set linker ROM ranges to 'default,-0-7FF' under "Memory model" pull-down.
+// Header pin checks - the optional modules share the H1-H4 header pins
+#if defined(ENCODERS) && defined(SONAR)
+#error "ENCODERS and SONAR both use H2"
+#endif
+#if defined(ENCODERS) && defined(ENCODER_QUADRATURE) && defined(REMOTE)
+#error "Quadrature ENCODERS and REMOTE both use H4"
+#endif
+#if defined(SENSOR_ARRAY) && (defined(ENCODERS) || defined(SONAR))
+#error "SENSOR_ARRAY uses H1 and H2"
+#endif
+#if !defined(REMOTE) && !(defined(ENCODERS) && defined(ENCODER_QUADRATURE))
+#define TELEMETRY               // H4 is free for telemetry output
+#endif
+
+// TODO Set linker ROM ranges to 'default,-0-7FF,-1F80-1FFF' under "Memory model" pull-down.
 // TODO Set linker code offset to '800' under "Additional options" pull-down.
 
 // Operating mode definitions
 #define digital 0               // Digital line following mode
 #define analog  1               // Analog line following mode
 
+// Analog sensing definitions
+#define SYNC_PAIRS  1           // Ambient light rejecting LED off/on sample
+                                // pairs averaged per reading (0 = raw levels)
+#define FILTER_SHIFT 1          // IIR sensor filter time constant (2^n
+                                // samples, 0 = unfiltered)
+#define SENSOR_CURVE CAL_LINEAR // Calibrated sensor normalization curve
+#define TRIM_LIMIT  32          // Largest motor balance trim (either way)
+#define REVERSE_MAX 64          // Fastest inner wheel reversing speed in
+                                // corners (0 = slow to a stop, no reverse)
+
+// Power saving definitions
+#define IDLE_BLINKS 29          // Mode selector D1 blinks before 500 kHz (5 s)
+#define PARK_BLINKS 172         // Mode selector D1 blinks before sleeping (30 s)
+
+// Obstacle sensing definitions (used when SONAR is defined, see Sonar.h)
+#define OBSTACLE_STOP 150       // Stop for obstacles closer than this (mm)
+#define OBSTACLE_CLEAR 200      // Resume when obstacles move beyond this (mm)
+#define OBSTACLE_SLOW 300       // Analog mode half speed distance (mm)
+
+// IR remote key definitions (NEC command codes of the common 21-key 'Car MP3'
+// remote, used when REMOTE is defined, see Remote.h). Change these to match
+// the command codes of your remote.
+#define KEY_DIGITAL 0x0C        // '1' - digital line-following mode
+#define KEY_ANALOG  0x18        // '2' - analog line-following mode
+#define KEY_FASTER  0x15        // 'VOL+' - increase analog base speed
+#define KEY_SLOWER  0x07        // 'VOL-' - decrease analog base speed
+#define KEY_KP_UP   0x08        // '4' - increase proportional gain
+#define KEY_KP_DOWN 0x42        // '7' - decrease proportional gain
+#define KEY_KI_UP   0x1C        // '5' - increase integral gain
+#define KEY_KI_DOWN 0x52        // '8' - decrease integral gain
+#define KEY_KD_UP   0x5A        // '6' - increase derivative gain
+#define KEY_KD_DOWN 0x4A        // '9' - decrease derivative gain
+#define KEY_TRIM_L  0x45        // 'CH-' - trim steering to the left
+#define KEY_TRIM_R  0x47        // 'CH+' - trim steering to the right
+#define KEY_SAVE    0x09        // 'EQ' - save settings (stop the robot first)
+#define KEY_DARKER  0x40        // 'NEXT' - raise the comparator dark threshold
+#define KEY_LIGHTER 0x44        // 'PREV' - lower the comparator dark threshold
+#define SPEED_STEP  8           // Base speed change per key press
+
+// Profiled code regions (see Profiler.h)
+#define PROF_DIGITAL 0          // Digital mode sensor read or line-edge
+                                // events, and table lookup
+#define PROF_SENSOR 1           // Analog mode sensor read, normalize, filter
+#define PROF_CONTROL 2          // Analog mode PID update
+#define PROF_MOTOR  3           // Analog mode PWM motor update
+
 // Light sensor digital level definitions
 #define light   0               // Light sensor is illuminated
 #define dark    1               // Light sensor is dark
@@ -39,30 +115,856 @@
 unsigned char mode = digital;   // Start in digital line-following mode
 unsigned char lightLevelLeft;   // Left sensor light level
 unsigned char lightLevelRight;  // Right sensor light level
+unsigned char lightLevels[ADC_SCAN_COUNT];  // Background ADC scan sample set
+int leftSpeed;                  // Left motor speed set by control task
+int rightSpeed;                 // Right motor speed set by control task
+int leftDrive;                  // Left motor speed set by velocity loop
+int rightDrive;                 // Right motor speed set by velocity loop
+int steering;                   // PID steering correction
+signed char motorTrim;          // Motor balance trim (+ = steer right)
+unsigned char lineThreshold = COMP_THRESHOLD;   // Comparator DAC threshold
+param_t params;                 // Saved calibration and settings (see Params.h)
+unsigned char buttonEvent;      // Pushbutton event read by select_task
+unsigned char idleBlinks;       // D1 blinks since the last mode selector input
+bool obstacle = false;          // Stopped for an obstacle
+bool obstacleNear = false;      // Obstacle closer than OBSTACLE_SLOW
+unsigned int loopTime;          // Timestamp of last control loop pass
+unsigned int loopPeriod;        // Control loop period (TMR0 counts)
 
-// LATC motor output constants. The four most sifnificant LATC bits control both 
-// motors as well as the D2-D5 LEDs. Change these bits to set the motor
-// direction. Leave the two least significant bits set to ensure floor LEDs
-// D6-D8 stay lit and the phototransistor circuits remain energized. If using
-// the 'fwd' motor constant causes either of your motors to run in reverse,
-// either swap that motor's wires on the CON1 motor header, or change swap the
-// pairs of output bits in the code, below: (e.g. 0b10... to 0b01... will change
-// the direction of motor 2)
-const char stop = 0b00000011;   // Both motors off, floor sensor LEDs on
-const char fwd = 0b10010011;    // Both motors forward, floor sensor LEDs on
-//const char rev                  // TODO - Add constants for all required directions
-//const char left
-//const char fwd_left
-//const char rev_left
-//const char right
-//const char fwd_right
-//const char rev_right
+// LATC motor direction constants, built from the motor pin map in Motors.h.
+// The four most significant LATC bits control both motors as well as the
+// D2-D5 LEDs. If using the 'fwd' motor constant causes either of your motors
+// to run in reverse, either swap that motor's wires on the CON1 motor header,
+// or set its swap flag (MOTOR_L_SWAP or MOTOR_R_SWAP) in Motors.h. Write the
+// constants to the motor pins with MOTOR_WRITE(), which leaves the other LATC
+// bits (including the floor sensor LEDs D6-D8) unchanged. The constants are
+// definitions (rather than const variables) so that they can be used to
+// initialize the motion tables, below.
+#define stop        0                           // Both motors off
+#define fwd         (MOTOR_L_FWD | MOTOR_R_FWD) // Both motors forward
+#define rev         (MOTOR_L_REV | MOTOR_R_REV) // Both motors reverse
+#define left        (MOTOR_L_REV | MOTOR_R_FWD) // Turn left on the spot
+#define fwd_left    (MOTOR_R_FWD)               // Forward left (M1 off, M2 fwd)
+#define rev_left    (MOTOR_R_REV)               // Reverse left (M1 off, M2 rev)
+#define right       (MOTOR_L_FWD | MOTOR_R_REV) // Turn right on the spot
+#define fwd_right   (MOTOR_L_FWD)               // Forward right (M1 fwd, M2 off)
+#define rev_right   (MOTOR_L_REV)               // Reverse right (M1 rev, M2 off)
+
+// Digital line-following motions. Change these to select the type of turn used
+// when only one sensor sees the line, and the motion used to 'undo' each turn
+// when both sensors lose the line.
+#define ON_LINE     fwd         // Both sensors see the line
+#define LINE_LEFT   fwd_left    // Only Q1 (left sensor) sees the line
+#define LINE_RIGHT  fwd_right   // Only Q2 (right sensor) sees the line
+#define UNDO_FWD    rev         // Line lost after driving forward
+#define UNDO_LEFT   rev_left    // Line lost after turning left
+#define UNDO_RIGHT  rev_right   // Line lost after turning right
+
+// Digital line-following states, representing the last motion. States are
+// multiples of 4 so that adding the Q2 and Q1 input bits (PORTC bits 3 and 2,
+// shifted right by 2) to the state forms an index into the motion tables.
+#define S_FWD       0           // Driving forward along the line
+#define S_LEFT      4           // Turning left towards the line
+#define S_RIGHT     8           // Turning right towards the line
+#define S_UNDO_FWD  12          // Undoing forward motion after losing line
+#define S_UNDO_LEFT 16          // Undoing left turn after losing line
+#define S_UNDO_RIGHT 20         // Undoing right turn after losing line
+
+// Digital motion tables, indexed by (state + Q2Q1). Each row lists the motor
+// output and next state for inputs Q2Q1 = 00 (line lost), 01 (only Q1 dark),
+// 10 (only Q2 dark), and 11 (both dark).
+const unsigned char digitalMotors[24] = {
+    UNDO_FWD,   LINE_LEFT, LINE_RIGHT, ON_LINE,     // S_FWD
+    UNDO_LEFT,  LINE_LEFT, LINE_RIGHT, ON_LINE,     // S_LEFT
+    UNDO_RIGHT, LINE_LEFT, LINE_RIGHT, ON_LINE,     // S_RIGHT
+    UNDO_FWD,   LINE_LEFT, LINE_RIGHT, ON_LINE,     // S_UNDO_FWD
+    UNDO_LEFT,  LINE_LEFT, LINE_RIGHT, ON_LINE,     // S_UNDO_LEFT
+    UNDO_RIGHT, LINE_LEFT, LINE_RIGHT, ON_LINE      // S_UNDO_RIGHT
+};
+
+const unsigned char digitalNext[24] = {
+    S_UNDO_FWD,   S_LEFT, S_RIGHT, S_FWD,           // S_FWD
+    S_UNDO_LEFT,  S_LEFT, S_RIGHT, S_FWD,           // S_LEFT
+    S_UNDO_RIGHT, S_LEFT, S_RIGHT, S_FWD,           // S_RIGHT
+    S_UNDO_FWD,   S_LEFT, S_RIGHT, S_FWD,           // S_UNDO_FWD
+    S_UNDO_LEFT,  S_LEFT, S_RIGHT, S_FWD,           // S_UNDO_LEFT
+    S_UNDO_RIGHT, S_LEFT, S_RIGHT, S_FWD            // S_UNDO_RIGHT
+};
+
+unsigned char digitalState = S_FWD; // Current digital line-following state
+bool digitalStopped;            // Motors stopped, state not applied
+unsigned int lineEdgeTime;      // Timestamp of the last line edge (TMR0 counts)
+
+// Interrupt service routine - pass each enabled interrupt to its handler
+void __interrupt() isr(void)
+{
+    if(TMR0IE && TMR0IF)
+    {
+        sched_isr();            // Count scheduler tick
+        buttons_isr();          // Sample and debounce pushbuttons
+    }
+    if(IOCIE && IOCIF)
+    {
+#ifdef SONAR
+        if(IOCBF6)
+        {
+            sonar_isr();        // Timestamp SONAR echo edge
+        }
+#endif
+#ifdef REMOTE
+        if(IOCBF7)
+        {
+            remote_isr();       // Decode IR remote edge
+        }
+#endif
+#ifdef ENCODERS
+        if(IOCBF & ENCODER_IOC)
+        {
+            encoder_isr();      // Count wheel encoder edges
+        }
+#endif
+    }
+#ifdef COMPARATORS
+    if(C1IE && (C1IF || C2IF))
+    {
+        comp_isr();             // Queue floor sensor line edge
+    }
+#endif
+    if(ADIE && ADIF)
+    {
+        ADC_scan_isr();         // Store ADC result and select next channel
+    }
+    if(TXIE && TXIF)
+    {
+        telemetry_isr();        // Send next queued telemetry byte
+    }
+}
+
+// Start a line-following mode. Digital mode reads the Q1/Q2 logic inputs (or
+// their comparator line-edge events) and drives the motors with LATC
+// constants, while analog mode scans the sensors with the ADC and drives the
+// motors with PWM.
+void set_mode(unsigned char newMode)
+{
+    if(newMode == digital)
+    {
+        MOTOR_WRITE(stop);      // Clear the analog drive's held motor pins
+        motor_release();        // Return motor pins to LATC motor constants
+        ADC_scan_stop();        // Use digital Q1/Q2 inputs
+#ifdef COMPARATORS
+        comp_start(lineThreshold);  // Or compare them with the DAC threshold
+#endif
+        D6 = 1;                 // Light the line and floor sensor LEDs
+        D8 = 1;
+        digitalState = S_FWD;
+        digitalStopped = true;  // Apply the current sensor levels first
+    }
+    else
+    {
+#ifdef COMPARATORS
+        comp_stop();            // Free Q1/Q2 for the ADC
+#endif
+        ADC_scan_start();       // Start background Q1/Q2 ADC conversions
+        ADC_scan_sync(SYNC_PAIRS);  // Reject ambient light if enabled
+        ADC_filter_reset();     // Clear sensor filter state
+        pid_reset();            // Clear PID controller state
+#ifdef TRACK
+        track_reset();          // Learn the track from the next marker
+#endif
+    }
+    mode = newMode;
+}
+
+// Restore the calibration tables, PID gains, base speed, motor trim, and
+// comparator threshold from the saved parameters
+void params_restore(void)
+{
+    for(unsigned char s = 0; s != CAL_SENSORS; s ++)
+    {
+        cal_min[s] = params.cal_min[s];
+        cal_max[s] = params.cal_max[s];
+    }
+    cal_build(params.cal_curve);
+#ifdef SENSOR_ARRAY
+    array_build();
+#endif
+    pid_kp = params.kp;
+    pid_ki = params.ki;
+    pid_kd = params.kd;
+    pid_base = params.base;
+    motorTrim = params.trim;
+    lineThreshold = params.threshold;
+}
+
+// Save the calibration, PID gains, base speed, motor trim, mode, and comparator
+// threshold if any of them have changed. Saving stalls the CPU for about 4 ms
+// (see Params.h).
+void params_save(void)
+{
+    param_t saved = params;
+    
+    for(unsigned char s = 0; s != CAL_SENSORS; s ++)
+    {
+        params.cal_min[s] = cal_min[s];
+        params.cal_max[s] = cal_max[s];
+    }
+    params.cal_curve = SENSOR_CURVE;
+    params.kp = pid_kp;
+    params.ki = pid_ki;
+    params.kd = pid_kd;
+    params.base = pid_base;
+    params.trim = motorTrim;
+    params.mode = mode;
+    params.threshold = lineThreshold;
+    for(unsigned char i = 0; i != PARAM_SIZE - 1; i ++)
+    {
+        if(((unsigned char *)&params)[i] != ((unsigned char *)&saved)[i])
+        {
+            param_save(&params);    // Only wear the HEF for new settings
+            return;
+        }
+    }
+}
+
+// Measure the control loop period (time since the previous pass)
+void loop_timer(void)
+{
+    unsigned int now = sched_time();
+    
+    loopPeriod = now - loopTime;
+    loopTime = now;
+    PROFILE_LOOP();
+}
+
+// Look up the motor output and next state for the Q2Q1 sensor levels in the
+// motion tables
+void digital_step(unsigned char sensors)
+{
+    unsigned char index = digitalState + sensors;
+    
+    MOTOR_WRITE(digitalMotors[index]);
+    digitalState = digitalNext[index];
+}
+
+// Digital mode line-following task - read both sensors with one PORTC read,
+// or take each line edge found by the comparators since the last tick in
+// order. The motion tables give the same result for repeated inputs, so with
+// comparators the motors only need to change at line edges.
+void digital_task(void)
+{
+    loop_timer();
+#ifdef COMPARATORS
+    unsigned char sensors;
+#endif
+    
+    PROFILE_START(PROF_DIGITAL);
+    if(obstacle)
+    {
+        MOTOR_WRITE(stop);      // Wait for the obstacle to clear
+        digitalStopped = true;
+#ifdef COMPARATORS
+        while(comp_event(&sensors, &lineEdgeTime))
+        {
+            ;                   // Discard edges crossed while stopped
+        }
+#endif
+    }
+    else
+    {
+#ifdef COMPARATORS
+        if(digitalStopped)
+        {
+            digital_step(comp_levels());    // Resume from the current levels
+        }
+        while(comp_event(&sensors, &lineEdgeTime))
+        {
+            digital_step(sensors);
+        }
+#else
+        digital_step((PORTC >> 2) & 0b00000011);
+#endif
+        digitalStopped = false;
+    }
+    PROFILE_END(PROF_DIGITAL);
+}
+
+// Analog mode sensor task - get the newest floor sensor samples (darker =
+// higher value)
+void sensor_task(void)
+{
+    loop_timer();
+    PROFILE_START(PROF_SENSOR);
+    ADC_scan_read(lightLevels);
+    lightLevelLeft = (unsigned char)ADC_filter_iir(SCAN_Q1,
+            CAL_NORM(SCAN_Q1, lightLevels[SCAN_Q1]), FILTER_SHIFT);
+    lightLevelRight = (unsigned char)ADC_filter_iir(SCAN_Q2,
+            CAL_NORM(SCAN_Q2, lightLevels[SCAN_Q2]), FILTER_SHIFT);
+    PROFILE_END(PROF_SENSOR);
+}
+
+// Limit a signed motor speed calculation to the -REVERSE_MAX to 255 range
+int speed_limit(int speed)
+{
+    if(speed > 255)
+    {
+        return (255);
+    }
+    if(speed < -REVERSE_MAX)
+    {
+        return (-REVERSE_MAX);
+    }
+    return (speed);
+}
+
+// Analog mode control task - steer using the PID controller. The line position
+// is the difference between the sensor light (dark) levels, or the weighted
+// centroid of the sensor array, and the steering correction speeds up one
+// motor and slows down the other from the base speed.
+// Large corrections reverse the inner wheel to turn sharply into corners.
+void control_task(void)
+{
+#ifdef TRACK
+    int average;
+#endif
+    
+    PROFILE_START(PROF_CONTROL);
+#ifdef SENSOR_ARRAY
+    steering = pid_update(array_position(lightLevels));
+#else
+    steering = pid_update((int)lightLevelLeft - lightLevelRight);
+#endif
+#ifdef TRACK
+    leftSpeed = speed_limit(pid_base + track_adjust + motorTrim + steering);
+    rightSpeed = speed_limit(pid_base + track_adjust - motorTrim - steering);
+#else
+    leftSpeed = speed_limit(pid_base + motorTrim + steering);
+    rightSpeed = speed_limit(pid_base - motorTrim - steering);
+#endif
+    if(obstacle)
+    {
+        leftSpeed = 0;          // Brake until the obstacle clears
+        rightSpeed = 0;
+    }
+    else if(obstacleNear)
+    {
+        leftSpeed /= 2;         // Slow down approaching an obstacle
+        rightSpeed /= 2;
+    }
+#ifdef TRACK
+    average = (leftSpeed + rightSpeed) / 2;
+    track_sample(steering, lightLevelLeft, lightLevelRight,
+            (average > 0) ? (unsigned char)average : 0);
+#endif
+    PROFILE_END(PROF_CONTROL);
+}
+
+#ifdef SONAR
+// SONAR task - advance SONAR ranging, and stop for obstacles closer than
+// OBSTACLE_STOP until they move further away than OBSTACLE_CLEAR
+void sonar_task(void)
+{
+    sonar_update();
+    obstacleNear = (sonar_distance < OBSTACLE_SLOW);
+    if(sonar_distance < OBSTACLE_STOP)
+    {
+        obstacle = true;
+    }
+    else if(sonar_distance > OBSTACLE_CLEAR)
+    {
+        obstacle = false;
+    }
+}
+#endif
+
+// Analog mode supply task - scale the PWM motor speeds to compensate for the
+// battery voltage (see Motors.h)
+void supply_task(void)
+{
+    motor_supply(ADC_scan_fvr());
+}
+
+// Analog mode motor task - update PWM motor speeds and directions, or brake
+// for an obstacle. The PWM hardware keeps driving the motors between updates.
+void motor_task(void)
+{
+    PROFILE_START(PROF_MOTOR);
+    if(obstacle)
+    {
+        motor_brake();
+    }
+    else
+    {
+#ifdef ENCODERS
+        motor_drive(leftDrive, rightDrive);
+#else
+        motor_drive(leftSpeed, rightSpeed);
+#endif
+    }
+    PROFILE_END(PROF_MOTOR);
+}
+
+#ifdef ENCODERS
+// Encoder task - measure the wheel speeds and distances, and in analog mode
+// run the velocity loops that make the wheels follow the motor speeds set by
+// the control task
+void encoder_task(void)
+{
+    encoder_update();
+    if(mode == analog)
+    {
+        leftDrive = encoder_control(ENCODER_LEFT, leftSpeed);
+        rightDrive = encoder_control(ENCODER_RIGHT, rightSpeed);
+    }
+}
+#endif
+
+// Read the current left and right sensor levels and motor commands into
+// status[0-3]. Digital mode gives the Q1/Q2 logic (or comparator) levels and
+// M1/M2 output bits, and analog mode gives half of each signed motor speed.
+void status_read(unsigned char *status)
+{
+    if(mode == digital)
+    {
+#ifdef COMPARATORS
+        status[1] = comp_levels();
+        status[0] = status[1] & 0b00000001;
+        status[1] >>= 1;
+#else
+        status[0] = Q1;
+        status[1] = Q2;
+#endif
+        status[2] = (LATC >> 4) & 0b00000011;
+        status[3] = LATC >> 6;
+    }
+    else
+    {
+        status[0] = lightLevelLeft;
+        status[1] = lightLevelRight;
+        status[2] = (unsigned char)(leftSpeed / 2);
+        status[3] = (unsigned char)(rightSpeed / 2);
+    }
+}
+
+// Telemetry task - queue a frame with the current sensor levels and motor
+// commands
+void telemetry_task(void)
+{
+    unsigned char status[4];
+    
+    status_read(status);
+    telemetry_frame(mode, status[0], status[1], status[2], status[3],
+                    loopPeriod);
+}
+
+#ifdef BLACKBOX
+// Black box task - record the current sensor levels and motor commands in
+// the persistent black box
+void blackbox_task(void)
+{
+    unsigned char status[4];
+    
+    status_read(status);
+    blackbox_record(mode, status[0], status[1], status[2], status[3],
+                    loopPeriod);
+}
+
+#ifdef TELEMETRY
+// Stream the black box recording from before the last reset: a statistics
+// frame with the record count and reset cause, then one telemetry frame per
+// record, oldest first. H4 is returned to SW5 afterwards.
+void blackbox_dump(void)
+{
+    blackbox_t record;
+    
+    telemetry_config();
+    telemetry_stats(BLACKBOX_ID, blackbox_count(), blackbox_cause,
+                    BLACKBOX_PERIOD, 0);
+    for(unsigned char i = 0; i != blackbox_count(); i ++)
+    {
+        blackbox_read(i, &record);
+        telemetry_flush();      // Wait for room rather than drop frames
+        telemetry_frame(record.status >> 7, record.sensorL, record.sensorR,
+                        record.motorL, record.motorR,
+                        (unsigned int)(record.status & 0b01111111) << 2);
+    }
+    telemetry_stop();
+}
+#endif
+#endif
+
+#ifdef PROFILE
+// Profiler task - send the next profiler statistics frame
+void profile_task(void)
+{
+    prof_report();
+}
+#endif
+
+#if defined(ENCODERS) && defined(TELEMETRY)
+// Odometry task - send a statistics frame with the wheel speeds in RPM and
+// the mean distance travelled by the wheels in millimetres
+void odometry_task(void)
+{
+    telemetry_stats(ENCODER_ID, (unsigned int)encoder_rpm(ENCODER_LEFT),
+                    (unsigned int)encoder_rpm(ENCODER_RIGHT),
+                    (unsigned int)((encoder_mm(ENCODER_LEFT) +
+                                    encoder_mm(ENCODER_RIGHT)) / 2), 0);
+}
+#endif
+
+#ifdef REMOTE
+// Remote task - switch modes and tune the analog mode base speed and PID gains
+// using IR remote keys. Holding a key down repeats it about every 108 ms.
+void remote_task(void)
+{
+    unsigned char key;
+
+    if(!remote_read(&key))
+    {
+        return;
+    }
+    if(key == KEY_DIGITAL && mode != digital)
+    {
+        set_mode(digital);
+    }
+    else if(key == KEY_ANALOG && mode != analog)
+    {
+        set_mode(analog);
+    }
+    else if(key == KEY_FASTER && pid_base <= 255 - SPEED_STEP)
+    {
+        pid_base += SPEED_STEP;
+    }
+    else if(key == KEY_SLOWER && pid_base >= SPEED_STEP)
+    {
+        pid_base -= SPEED_STEP;
+    }
+    else if(key == KEY_KP_UP && pid_kp != 255)
+    {
+        pid_kp ++;
+    }
+    else if(key == KEY_KP_DOWN && pid_kp != 0)
+    {
+        pid_kp --;
+    }
+    else if(key == KEY_KI_UP && pid_ki != 255)
+    {
+        pid_ki ++;
+    }
+    else if(key == KEY_KI_DOWN && pid_ki != 0)
+    {
+        pid_ki --;
+    }
+    else if(key == KEY_KD_UP && pid_kd != 255)
+    {
+        pid_kd ++;
+    }
+    else if(key == KEY_KD_DOWN && pid_kd != 0)
+    {
+        pid_kd --;
+    }
+    else if(key == KEY_TRIM_L && motorTrim != -TRIM_LIMIT)
+    {
+        motorTrim --;
+    }
+    else if(key == KEY_TRIM_R && motorTrim != TRIM_LIMIT)
+    {
+        motorTrim ++;
+    }
+#ifdef COMPARATORS
+    else if(key == KEY_DARKER && lineThreshold != COMP_LEVEL_MAX)
+    {
+        lineThreshold ++;
+        comp_threshold(lineThreshold);
+    }
+    else if(key == KEY_LIGHTER && lineThreshold != 0)
+    {
+        lineThreshold --;
+        comp_threshold(lineThreshold);
+    }
+#endif
+    else if(key == KEY_SAVE)
+    {
+        params_save();
+    }
+}
+#endif
+
+// Button task - reset the microcontroller and start the bootloader if SW1 is
+// pressed
+void button_task(void)
+{
+    if(button_event() == (BUTTON_PRESSED | 1))
+    {
+        RESET();
+    }
+}
+
+// Mode select task - read the next pushbutton event for the mode selector
+void select_task(void)
+{
+    buttonEvent = button_event();
+}
+
+// Blink task - toggle LED D1 and count blinks while waiting for a mode
+// selection
+void blink_task(void)
+{
+    D1 = ~D1;
+    idleBlinks ++;
+}
+
+// Calibrate the floor sensors by spinning the robot left, right, and back to
+// its starting direction across the line while recording each sensor's light
+// level range, then build the sensor normalization tables. The ranges come
+// from the oversampled 12-bit levels, so single noisy samples cannot widen them.
+void calibrate(void)
+{
+    unsigned int levels[ADC_SCAN_COUNT];    // 12-bit sensor levels
+    
+    buttons_mask(BUTTONS_ALL & ~ADC_SCAN_PINS); // Ignore analog header pins
+    ADC_scan_start();           // Start background Q1/Q2 ADC conversions
+    ADC_scan_sync(SYNC_PAIRS);  // Use the same sensing mode as analog mode
+    cal_reset();
+    for(unsigned int t = 0; t != 1500; t ++)
+    {
+        if(t == 0 || t == 1125)
+        {
+            MOTOR_WRITE(left);
+        }
+        else if(t == 375)
+        {
+            MOTOR_WRITE(right);     // Twice as long, to end where it started
+        }
+        if(ADC_scan_hires(levels) != 0)     // Once there is a 12-bit set
+        {
+            for(unsigned char s = 0; s != ADC_SCAN_COUNT; s ++)
+            {
+                lightLevels[s] = (unsigned char)(levels[s] >> 4);
+            }
+            cal_sample(lightLevels);
+        }
+        __delay_ms(1);
+    }
+    MOTOR_WRITE(stop);
+    ADC_scan_stop();            // Until a line-following mode starts
+    buttons_mask(BUTTONS_ALL);
+    cal_build(SENSOR_CURVE);
+#ifdef SENSOR_ARRAY
+    array_build();
+#endif
+    params_save();              // Keep the calibration for the next start
+}
+
+// Scheduler task tables: task function, period (ticks), budget (TMR0 counts).
+// One tick is 683 us and one TMR0 count is 2.67 us (see Scheduler.h).
+sched_task_t selectTasks[] = {
+    {select_task, 1, 4},        // Pushbutton events every tick
+    {blink_task, 255, 4},       // Toggle D1 every 174 ms
+};
+#define SELECT_TASKS (sizeof(selectTasks) / sizeof(selectTasks[0]))
+
+sched_task_t digitalTasks[] = {
+    {digital_task, 1, 8},       // Line following every tick, 21 us budget
+    {button_task, 16, 4},       // Buttons every 10.9 ms, 11 us budget
+#ifdef SONAR
+    {sonar_task, 1, 24},        // SONAR ranging, 64 us budget
+#endif
+#ifdef ENCODERS
+    {encoder_task, ENCODER_PERIOD, 96}, // Odometry every 5.5 ms, 256 us budget
+#endif
+#ifdef BLACKBOX
+    {blackbox_task, BLACKBOX_PERIOD, 16},   // Black box record every 5.5 ms
+#endif
+#ifdef REMOTE
+    {remote_task, 16, 16},      // IR remote keys every 10.9 ms
+#endif
+#ifdef TELEMETRY
+    {telemetry_task, 8, 8},     // Telemetry at 183 Hz (1830 bytes/s)
+#ifdef PROFILE
+    {profile_task, 64, 40},     // Profiler statistics every 43.7 ms
+#endif
+#ifdef ENCODERS
+    {odometry_task, 64, 128, 32},   // Odometry statistics every 43.7 ms, half
+                                    // a period after the profiler's
+#endif
+#endif
+#ifdef PROFILE
+    {prof_fold, 1, 16},         // Profiler statistics, after the profiled tasks
+#endif
+};
+#define DIGITAL_TASKS (sizeof(digitalTasks) / sizeof(digitalTasks[0]))
+
+sched_task_t analogTasks[] = {
+    {sensor_task, 1, 8},        // Newest ADC sample set every tick (680 us)
+#ifdef SENSOR_ARRAY
+    {control_task, 1, 48},      // Array position and PID update, about 100 us
+#else
+    {control_task, 1, 24},      // PID update, about 50 us (see PID.h)
+#endif
+    {motor_task, 1, 12},       // Supply-scaled PWM update, about 25 us
+    {supply_task, 255, 24},     // Supply compensation every 174 ms
+#ifdef TRACK
+    {track_update, TRACK_UNIT, 40}, // Track log every 10.9 ms, 107 us budget
+#endif
+    {button_task, 16, 4},
+#ifdef SONAR
+    {sonar_task, 1, 24},
+#endif
+#ifdef ENCODERS
+    {encoder_task, ENCODER_PERIOD, 96},
+#endif
+#ifdef BLACKBOX
+    {blackbox_task, BLACKBOX_PERIOD, 16},
+#endif
+#ifdef REMOTE
+    {remote_task, 16, 16},
+#endif
+#ifdef TELEMETRY
+    {telemetry_task, 8, 8},
+#ifdef PROFILE
+    {profile_task, 64, 40},
+#endif
+#ifdef ENCODERS
+    {odometry_task, 64, 128, 32},
+#endif
+#endif
+#ifdef PROFILE
+    {prof_fold, 1, 16},
+#endif
+};
+#define ANALOG_TASKS (sizeof(analogTasks) / sizeof(analogTasks[0]))
 
 int main(void)
 {
     OSC_config();               // Configure oscillator for 48 MHz
     CHRP4_config();             // Configure I/O for on-board CHRP4 devices
+    motor_config();             // Configure Timer2 PWM background motor drive
+    TMR1_config();              // Start Timer1 instruction cycle counter
+#ifdef PROFILE
+    prof_reset();               // Clear profiler statistics
+#endif
+#ifdef BLACKBOX
+    if(blackbox_boot())         // Check for a recording from before a reset
+    {
+#ifdef TELEMETRY
+        blackbox_dump();        // Stream it out on H4
+#endif
+    }
+#endif
     
+    if(param_load(&params))     // Restore the saved calibration and settings
+    {
+        params_restore();
+        mode = params.mode;
+    }
+    else
+    {
+        cal_reset();            // Use 1:1 sensor tables until calibrated
+        cal_build(CAL_LINEAR);
+    }
+    sched_start();              // Start Timer0 tick and pushbutton sampling
+    power_clock(POWER_16MHZ);   // Save power while waiting
+    
+    // Wait for a button press. SW2 starts the last saved line-following mode,
+    // SW3 starts digital line-following mode, SW4 starts analog line-following
+    // mode, and SW5 calibrates the floor sensors (place the robot over the line
+    // first). If no button is pressed for 5 seconds, slow the clock to 500 kHz,
+    // and after 30 seconds sleep until the next button press.
+    do
+    {
+        sched_run(selectTasks, SELECT_TASKS);   // Blink D1 and read buttons
+        
+        if(buttonEvent == (BUTTON_PRESSED | 5)) // Check SW5 to calibrate
+        {
+            power_clock(POWER_48MHZ);   // Calibrate at full speed (delays)
+            calibrate();
+            power_clock(POWER_16MHZ);
+            idleBlinks = 0;
+        }
+        
+        if(idleBlinks == IDLE_BLINKS && power_profile != POWER_500KHZ)
+        {
+            power_clock(POWER_500KHZ);  // Keep waiting at the lowest clock
+        }
+        
+        if(idleBlinks == PARK_BLINKS)
+        {
+            D1 = 1;             // Turn D1 off and sleep until a button press
+            power_sleep();
+            power_clock(POWER_16MHZ);
+            idleBlinks = 0;
+        }
+        
+        if(buttonEvent == (BUTTON_PRESSED | 1)) // Check SW1 to re-start
+        {                                       // the bootloader
+            RESET();
+        }
+    } while(buttonEvent != (BUTTON_PRESSED | 2) &&
+            buttonEvent != (BUTTON_PRESSED | 3) &&
+            buttonEvent != (BUTTON_PRESSED | 4));
+    D1 = 0;                     // Leave D1 on after switch press
+    power_clock(POWER_48MHZ);   // Run at full speed
+    
+    // Set mode, and save it if it is a new selection
+    if(buttonEvent == (BUTTON_PRESSED | 3))
+    {
+        mode = digital;
+    }
+    else if(buttonEvent == (BUTTON_PRESSED | 4))
+    {
+        mode = analog;
+    }
+    params_save();
+    set_mode(mode);
+    D6 = 1;                     // Turn line sensor LED on
+#ifdef SONAR
+    buttons_mask(BUTTONS_ALL & ~(BUTTON_BIT(3) | BUTTON_BIT(4) | BUTTON_BIT(5)));
+    sonar_start();              // Start SONAR ranging on H2 (TRIG) and H3 (ECHO)
+#elif defined(ENCODERS)
+    buttons_mask(BUTTONS_ALL & ~(ENCODER_IOC | BUTTON_BIT(5)));
+    encoder_start();            // Start counting wheel encoder edges on H1-H4
+#elif defined(SENSOR_ARRAY)
+    buttons_mask(BUTTONS_ALL & ~(ADC_SCAN_PINS | BUTTON_BIT(5)));
+#else
+    buttons_mask(BUTTONS_ALL & ~BUTTON_BIT(5)); // Stop sampling SW5 (H4)
+#endif
+#ifdef REMOTE
+    remote_start();             // Start IR remote decoding on IRIN (H4)
+#endif
+#ifdef TELEMETRY
+    telemetry_config();         // Start telemetry output on H4
+#endif
+#ifdef BLACKBOX
+    blackbox_start();           // Record this run in the black box
+#endif
+            
+    while(1)
+    {
+        while(mode == digital)
+        {
+            sched_run(digitalTasks, DIGITAL_TASKS);
+        }
+        
+        while(mode == analog)
+        {
+            sched_run(analogTasks, ANALOG_TASKS);
+        }
+    }
+}
+
+/* Learn More -- Program Analysis Activities
+ * 
+ * 1.   After assembling your CHRP4 circuit board into your robot chassis and
+ *      installing the optical line sensor components, the next step should be
+ *      to test these components and ensure that they can distinguish between
+ *      light and dark surfaces. The temporary light sensor test code below
+ *      does just that. Add it to the main() function, directly after the
+ *      CHRP4_config(); statement, so that it runs instead of the mode
+ *      selector. It first lights the line sensor LED (LED D6), and then reads
+ *      and displays the light levels from the Q1 and Q2 phototransistors using
+ *      LEDs D2 and D5:
+
     D6 = 1;                     // Turn line sensor LED on
     
     // Light sensor test code
@@ -92,39 +994,7 @@ int main(void)
             RESET();
         }
     }
-            
-    while(1)
-    {
-        while(mode == digital)
-        {
-            if(Q1 == dark && Q2 == dark)    // If both sensors see the line...
-            {
-                LATC = fwd;     // Drive both motors forward
-            }
-            else if(Q1 == dark && Q2 == light)  // If only Q1 sees the line...
-            {
-                // TODO - Determine direction to drive in
-            }
-            // TODO - Add additional light sensor checks and motor output code
-            
-            // Reset the microcontroller and start the bootloader if SW1 is pressed.
-            if(SW1 == 0)
-            {
-                RESET();
-            }
-        }
-    }
-}
 
-/* Learn More -- Program Analysis Activities
- * 
- * 1.   After assembling your CHRP4 circuit board into your robot chassis and
- *      installing the optical line sensor components, the next step should be
- *      to test these components and ensure that they can distinguish between
- *      light and dark surfaces. The first while(1) loop in the main part of
- *      this starter program is temporary code that does just that. It first
- *      lights the line sensor LED (LED D6), and then reads and displays the
- *      light levels from the Q1 and Q2 phototransistors using LEDs D2 and D5.
  *      Note that D6 is an infrared (IR) LED, so you won't be able to see the
  *      light produced by it, but the phototransistors should see the light from
  *      D6 reflected by white or light-coloured surfaces below them.
@@ -159,6 +1029,9 @@ int main(void)
  *      light? (Hint: refer to the schematic to determine how they they are
  *      connected in the circuit.)
  * 
+ *      Remove the test code (or comment it out) when you are done, so that
+ *      the program continues to the mode selector again.
+ * 
  * 2.   Now that we have characterized the operation of the phototransistors
  *      in this circuit, we can make it easier for us and others to modify the
  *      program in the future by creating definitions for the expected light
@@ -180,20 +1053,20 @@ int main(void)
  *      and the two right motor wires to the M2 terminals of your CHRP4.
  * 
  *      Next, modify the code at the beginning of the main() function to add
- *      the LATC output instruction, while loop, and RESET() function call below
+ *      the MOTOR_WRITE() statement, while loop, and RESET() function call below
  *      the D6 = 1; statement as shown below. This will set the motor outputs
  *      to a specific value while ignoring any sensor inputs other than waiting
  *      for the reset button to be pressed:
     
     D6 = 1;                     // Turn line sensor LED on
-    LATC = fwd;
+    MOTOR_WRITE(fwd);
     while(SW1 == 1);
     RESET();
     
- *      The 'fwd' constant used in the LATC statement was defined by this 
- *      statement, above the main program code:
+ *      The 'fwd' constant used in the MOTOR_WRITE() statement was defined by
+ *      this statement, above the main program code:
 
-const char fwd = 0b10010011;    // Both motors forward, floor sensor LEDs on
+#define fwd         (MOTOR_L_FWD | MOTOR_R_FWD) // Both motors forward
 
  *      Refer to the CHRP4 schematic to examine the PORTC (RC0-RC7) connections.
  *      PORTC connects to the floor LEDs and phototransistors, as well as the
@@ -207,34 +1080,46 @@ const char fwd = 0b10010011;    // Both motors forward, floor sensor LEDs on
  *      11 - motor off (motor outputs: +,+)
  * 
  *      The two highest order bits connect to M2, the right motor, and the next
- *      two bits connect to M1, the left motor. Assuming the motors are wired
- *      and connected the same way, the pre-defined 'fwd' motor constant drives
- *      the right motor in one direction using the value '10', and the left 
- *      motor in the opposite direction using the value '01'. Since the left and
- *      right motors are located on the opposite sides of the robot, these 
- *      constants should make the motors drive the robot in either the forward
- *      or reverse direction if your motors are wired in the same way.
+ *      two bits connect to M1, the left motor. The motor pin map in Motors.h
+ *      gives the LATC bit of each motor output, and makes a forward and a
+ *      reverse bit for each motor from it. MOTOR_L_FWD is the M1A bit and
+ *      MOTOR_R_FWD is the M2B bit, so 'fwd' is 0b10010000 -- the right motor
+ *      gets the value '10', and the left motor the opposite value '01'. Since
+ *      the left and right motors are located on the opposite sides of the
+ *      robot, this should make the motors drive the robot in either the
+ *      forward or reverse direction if your motors are wired in the same way.
+ * 
+ *      MOTOR_WRITE() changes only the four motor bits of LATC, so the floor
+ *      sensor LEDs D6-D8 in the lowest LATC bits stay lit. The motor constants
+ *      contain no LED bits, so writing one with LATC = fwd; would turn the
+ *      LEDs off.
  * 
- *      If your robot drives forward, you're all set to move on to defining
+ *      If your robot drives forward, you're all set to move on to testing
  *      the other motor constants in the next step.
  * 
  *      If your robot drives reverse, you have two choices: either swap each of
- *      the motor wire connections on the terminal strip, or re-define the 'fwd'
- *      constant to reverse the output bit pairs, like this:
+ *      the motor wire connections on the terminal strip, or set both motor
+ *      swap flags in the pin map in Motors.h, like this:
 
-const char fwd = 0b01100011;    // Both motors forward, floor sensor LEDs on
+#define MOTOR_L_SWAP    1           // 1 if the left motor is wired in reverse
+#define MOTOR_R_SWAP    1           // 1 if the right motor is wired in reverse
 
- *      If one motor drives forward, and the other reverse, swap the wires of
- *      the reverse motor to get it to drive forward.
+ *      A swap flag exchanges the forward and reverse bits of its motor, so
+ *      every motor constant (and the PWM motor drive used in analog mode)
+ *      changes with it, and 'fwd' does not need to be edited. If one motor
+ *      drives forward, and the other reverse, swap the wires of the reverse
+ *      motor, or set only its swap flag, to get it to drive forward.
  * 
  *      Hint for teachers and makerspace instructors: have all of your students
  *      or participants wire their motors the same way so that it's easier for
  *      students to work together on programming and to share the same code.
  * 
  * 4.   Complete the motor direction definitions for all possible driving
- *      directions. Assuming the values '10' in the first two bits of the 'fwd'
- *      motion definition drive M2 forward, changing these bits to '01' should
- *      drive M2 in reverse, while '00' will make M2 stop.
+ *      directions. Each motor constant is made from the Motors.h direction
+ *      bits: MOTOR_R_FWD drives M2 forward, MOTOR_R_REV drives it in reverse,
+ *      and leaving out both of its bits stops it (MOTOR_L_FWD and MOTOR_L_REV
+ *      do the same for M1). Built this way, the constants stay correct when a
+ *      motor's swap flag is changed.
  * 
  *      Using three possible values for forward, reverse, and stop, for each of
  *      the two motors, your robot will be able to drive in up to 8 different
@@ -251,8 +1136,12 @@ const char fwd = 0b01100011;    // Both motors forward, floor sensor LEDs on
  *      using a left turn (on the spot), or more safely avoid an obstacle using
  *      a reverse left turn.
  * 
- *      Define the constants for all of the motor directions and try each one
- *      in your program to confirm its operation.
+ *      Define the constants for all of the motor directions, like this one:
+
+#define fwd_left    (MOTOR_R_FWD)               // Forward left (M1 off, M2 fwd)
+
+ *      and try each one in your program with MOTOR_WRITE() to confirm its
+ *      operation.
  * 
  * 5.   Once the light sensors have been tested and the motor outputs have been
  *      defined, it's time to put both the input and output code together to
@@ -270,7 +1159,7 @@ const char fwd = 0b01100011;    // Both motors forward, floor sensor LEDs on
         {
             if(Q1 == dark && Q2 == dark)    // If both sensors see the line...
             {
-                LATC = fwd;     // Drive both motors forward
+                MOTOR_WRITE(fwd);   // Drive both motors forward
             }
             else if(Q1 == dark && Q2 == light)  // If only Q1 sees the line...
 
@@ -371,11 +1260,10 @@ void pwm_motors(unsigned char lVal, unsigned char rVal)
  *      Try to implement one or more modifications in your robot program code
  *      to improve its performance when following a line.
  * 
- * 8.   While a LATC statement has been used to output motor constants to the
- *      four motor port pins, a safer method of motor output uses logical
- *      operations to avoid over-writing the other PORTC pins. Since this
- *      would involve more than one line of code, it might be easier to
- *      implment this in its own function:
+ * 8.   Writing a whole motor constant to LATC would also over-write the other
+ *      PORTC pins. A simple way to send motor constants only to the motor
+ *      pins uses logical operations, and since this involves more than one
+ *      line of code, it might be easier to implment it in its own function:
 
 // motors function - safely send LATC motor constants only to motor I/O pins
 void motors(unsigned char dir)
@@ -384,12 +1272,15 @@ void motors(unsigned char dir)
     LATC = LATC | dir;          // Write motor constant to motor outputs
 }
 
- *      The motors() function uses the same direction constants that were
- *      defined for the LATC statement, but only modifies the four motor pins
- *      instead of re-writing the entire port. It can be called by your
- *      program like this:
+ *      The motors() function only modifies the four motor pins instead of
+ *      re-writing the entire port, but between its two statements all of the
+ *      motor pins are briefly off. The MOTOR_WRITE() macro used by this
+ *      program (see Motors.h) does the same job with a single XOR of only the
+ *      motor bits that need to change, so the motors never pass through that
+ *      in-between state. Both are used in the same way:
 
         motors(fwd);
+        MOTOR_WRITE(fwd);
 
  * 9.   Another option that could be added to the robot program is mode
  *      switching between the digital and analog modes. Below is a version of
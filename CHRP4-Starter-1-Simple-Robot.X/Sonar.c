@@ -0,0 +1,161 @@
+/*==============================================================================
+ File: Sonar.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) non-blocking SONAR ranging functions
+
+ Interrupt-on-change echo timing for an HC-SR04 style ultrasonic SONAR module
+ on TRIG (RB5) and ECHO (RB6), driven by the Timer0 tick scheduler. These
+ functions are only compiled when SONAR is defined. Include the Sonar.h file in
+ your main program to call these functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "CHRP4.h"           // Include CHRP4 constant & function definitions
+#include    "Scheduler.h"       // Include scheduler time base functions
+#include    "Sonar.h"           // Include SONAR constant & function definitions
+
+#ifdef SONAR
+
+// SONAR ranging states
+#define SONAR_OFF       0           // Ranging stopped
+#define SONAR_IDLE      1           // Waiting to send the next ping
+#define SONAR_TRIG      2           // TRIG pulse is being sent
+#define SONAR_WAIT      3           // Waiting for the echo pulse to start
+#define SONAR_ECHO      4           // Waiting for the echo pulse to end
+#define SONAR_DONE      5           // Echo pulse width is ready
+
+unsigned int sonar_distance = SONAR_NONE;   // Filtered distance (mm)
+volatile unsigned char sonar_state = SONAR_OFF; // Ranging state
+volatile unsigned int sonar_rise;   // Echo start timestamp (TMR0 counts)
+volatile unsigned int sonar_width;  // Echo pulse width (TMR0 counts)
+unsigned char sonar_timer;          // Ticks since the last ping
+unsigned int sonar_history[3];      // Last three distances for median filter
+unsigned char sonar_next;           // Next history entry to replace
+
+// Start ranging, sending the first ping on the next update.
+void sonar_start(void)
+{
+    for(unsigned char i = 0; i != 3; i ++)
+    {
+        sonar_history[i] = SONAR_NONE;
+    }
+    sonar_distance = SONAR_NONE;
+    sonar_timer = SONAR_PERIOD - 1;
+    sonar_state = SONAR_IDLE;
+
+    TRIG = 0;
+    TRISB = TRISB & 0b11011111; // Make TRIG (RB5) an output
+    IOCBP = IOCBP | SONAR_IOC;  // Interrupt on both edges of ECHO (RB6)
+    IOCBN = IOCBN | SONAR_IOC;
+    IOCBF6 = 0;
+    IOCIE = 1;                  // Enable interrupt-on-change
+}
+
+// Stop ranging and release the TRIG and ECHO pins.
+void sonar_stop(void)
+{
+    IOCBP = IOCBP & ~SONAR_IOC;
+    IOCBN = IOCBN & ~SONAR_IOC;
+    sonar_state = SONAR_OFF;
+    TRIG = 0;
+    TRISB = TRISB | 0b00100000; // Return RB5 to an input
+    sonar_distance = SONAR_NONE;
+}
+
+// Convert an echo pulse width to a distance and publish the median of the
+// last three distances, which rejects single missed or false echoes.
+void sonar_publish(unsigned int width)
+{
+    unsigned int a, b, c;
+    unsigned int mm = SONAR_NONE;
+
+    if(width != SONAR_NONE)
+    {
+        mm = (unsigned int)(((unsigned long)width * SONAR_MM_Q8) >> 8);
+        if(mm > SONAR_RANGE)
+        {
+            mm = SONAR_NONE;
+        }
+    }
+    sonar_history[sonar_next] = mm;
+    sonar_next = (sonar_next == 2) ? 0 : sonar_next + 1;
+
+    a = sonar_history[0];
+    b = sonar_history[1];
+    c = sonar_history[2];
+    if((a <= b && b <= c) || (c <= b && b <= a))
+    {
+        sonar_distance = b;
+    }
+    else if((b <= a && a <= c) || (c <= a && a <= b))
+    {
+        sonar_distance = a;
+    }
+    else
+    {
+        sonar_distance = c;
+    }
+}
+
+// Advance the ranging state machine by one tick. The echo edges are handled
+// by sonar_isr(), so this function never waits.
+void sonar_update(void)
+{
+    unsigned char state = sonar_state;
+
+    if(state == SONAR_OFF)
+    {
+        return;
+    }
+    sonar_timer ++;
+
+    if(state == SONAR_TRIG)
+    {
+        sonar_state = SONAR_WAIT;   // The module pings after TRIG falls
+        TRIG = 0;
+    }
+    else if(state == SONAR_DONE)
+    {
+        sonar_publish(sonar_width);
+        sonar_state = SONAR_IDLE;
+    }
+    else if(state != SONAR_IDLE && sonar_timer == SONAR_TIMEOUT)
+    {
+        sonar_state = SONAR_IDLE;   // No echo, or echo too long
+        sonar_publish(SONAR_NONE);
+    }
+
+    if(sonar_state == SONAR_IDLE && sonar_timer >= SONAR_PERIOD)
+    {
+        sonar_timer = 0;
+        sonar_state = SONAR_TRIG;
+        TRIG = 1;                   // Start the next ping
+    }
+}
+
+// Timestamp the rising and falling edges of the echo pulse.
+void sonar_isr(void)
+{
+    unsigned int now = sched_isr_time();
+
+    IOCBF6 = 0;
+    if(ECHO == 1)
+    {
+        if(sonar_state == SONAR_WAIT)
+        {
+            sonar_rise = now;
+            sonar_state = SONAR_ECHO;
+        }
+    }
+    else if(sonar_state == SONAR_ECHO)
+    {
+        sonar_width = now - sonar_rise;
+        sonar_state = SONAR_DONE;
+    }
+}
+
+#endif
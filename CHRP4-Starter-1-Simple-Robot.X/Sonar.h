@@ -0,0 +1,85 @@
+/*==============================================================================
+ File: Sonar.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) non-blocking SONAR ranging constant and function
+ definitions.
+
+ SONAR module connections:
+ An HC-SR04 style ultrasonic SONAR module connects its Trig input to TRIG (RB5,
+ header H2) and its Echo output to ECHO (RB6, header H3). These pins are shared
+ with pushbuttons SW3 and SW4, which must not be pressed (or sampled, see
+ buttons_mask()) while the SONAR module is running.
+
+ SONAR enable section:
+ SONAR ranging code is only compiled when SONAR is defined, either by removing
+ the comment from the definition below or by adding SONAR to the project's XC8
+ compiler 'Define macros' setting. Leave SONAR undefined when no SONAR module
+ is installed, so that SW3 and SW4 remain usable.
+
+ Ranging:
+ sonar_update() is called from a scheduler task every tick. Every SONAR_PERIOD
+ ticks (60 ms) it raises TRIG for one tick (683 us, well over the module's 10 us
+ minimum) and then waits for the echo pulse. Both edges of the echo pulse are
+ timestamped by the RB6 interrupt-on-change handler, sonar_isr(), using the
+ scheduler's tick:TMR0 time base (2.67 us, or 0.46 mm, per count), so ranging
+ never waits for the echo. The pulse width is converted to millimetres, and
+ the median of the last three readings is published in sonar_distance, which
+ the main program can read at any time. Echoes that do not end within
+ SONAR_TIMEOUT ticks, or that are longer than SONAR_RANGE millimetres, are
+ counted as SONAR_NONE (no obstacle).
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the Sonar.c file.
+==============================================================================*/
+
+// SONAR enable definition
+//#define SONAR
+
+// SONAR definitions
+#define SONAR_PERIOD    88          // Ticks between pings (60 ms)
+#define SONAR_TIMEOUT   59          // Ticks to wait for an echo (40 ms)
+#define SONAR_RANGE     4000        // Longest valid distance (mm)
+#define SONAR_MM_Q8     117         // Millimetres per TMR0 count (Q8, 0.457)
+#define SONAR_NONE      0xFFFF      // Distance when no obstacle is in range
+#define SONAR_IOC       0b01000000  // ECHO (RB6) interrupt-on-change bit
+
+#ifdef SONAR
+
+// Filtered obstacle distance (mm, or SONAR_NONE)
+extern unsigned int sonar_distance;
+
+// Prototypes for Sonar.c functions:
+
+/**
+ * Function: void sonar_start(void)
+ *
+ * Make TRIG an output, enable ECHO interrupt-on-change on both edges, and start
+ * ranging on the next call to sonar_update().
+ */
+void sonar_start(void);
+
+/**
+ * Function: void sonar_stop(void)
+ *
+ * Stop ranging, disable ECHO interrupt-on-change, and return TRIG to being a
+ * pushbutton input.
+ */
+void sonar_stop(void);
+
+/**
+ * Function: void sonar_update(void)
+ *
+ * SONAR ranging state machine. Call once per scheduler tick to trigger pings
+ * and publish new distances. Does nothing unless sonar_start() has been called.
+ */
+void sonar_update(void);
+
+/**
+ * Function: void sonar_isr(void)
+ *
+ * ECHO (RB6) interrupt-on-change handler. Timestamps the echo pulse edges.
+ */
+void sonar_isr(void);
+
+#endif
@@ -0,0 +1,143 @@
+/*==============================================================================
+ File: Telemetry.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) EUSART telemetry functions
+
+ Functions to stream compact binary telemetry frames from the EUSART using an
+ interrupt-driven transmit ring buffer, so that logging never blocks the robot
+ control loop. Include the Telemetry.h file in your main program to call these
+ functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "CHRP4.h"           // Include SIMULATION definition
+#include    "Telemetry.h"       // Include telemetry constant & function definitions
+
+unsigned char telemetry_buffer[TELEMETRY_BUFFER];   // Transmit ring buffer
+volatile unsigned char telemetry_head;  // Next buffer index to write
+volatile unsigned char telemetry_tail;  // Next buffer index to transmit
+unsigned char telemetry_seq;            // Frame sequence number
+unsigned char telemetry_drops;          // Frames dropped (buffer full)
+unsigned char telemetry_sum;            // Checksum of frame being queued
+
+// Configure the EUSART for 115200 baud, 8N1, transmit only.
+void telemetry_config(void)
+{
+    TXIE = 0;
+    telemetry_head = 0;
+    telemetry_tail = 0;
+    BAUDCON = 0b00001000;       // 16-bit baud rate generator (BRG16)
+    SPBRGH = 0;
+    SPBRGL = TELEMETRY_SPBRG;
+    TXSTA = 0b00100100;         // Transmit enabled, async, high speed (BRGH)
+    RCSTA = 0b10000000;         // Serial port enabled (SPEN), receiver off
+}
+
+// Wait for the transmit interrupt to empty the ring buffer.
+void telemetry_flush(void)
+{
+#ifndef SIMULATION
+    while(TXIE)                 // Cleared once the buffer is empty
+        ;
+#endif
+}
+
+// Send the queued bytes and then disable the EUSART.
+void telemetry_stop(void)
+{
+    telemetry_flush();
+#ifndef SIMULATION
+    while(!TRMT)                // Wait for the last byte to be shifted out
+        ;
+#endif
+    TXSTA = 0b00000000;         // Transmitter off
+    RCSTA = 0b00000000;         // Serial port disabled, RB7 is port I/O again
+}
+
+// Transmit interrupt - send the next queued byte, or stop when none are left.
+void telemetry_isr(void)
+{
+    if(telemetry_tail == telemetry_head)
+    {
+        TXIE = 0;               // Buffer empty - stop transmit interrupts
+        return;
+    }
+    TXREG = telemetry_buffer[telemetry_tail];
+    telemetry_tail = (telemetry_tail + 1) & (TELEMETRY_BUFFER - 1);
+}
+
+// Add a byte to the ring buffer and to the frame checksum. Only called once
+// there is known to be room for a whole frame.
+void telemetry_put(unsigned char data)
+{
+    telemetry_buffer[telemetry_head] = data;
+    telemetry_head = (telemetry_head + 1) & (TELEMETRY_BUFFER - 1);
+    telemetry_sum += data;
+}
+
+// Start a new frame with the sync byte if there is room for all of it in the
+// ring buffer, or count a dropped frame and return false if there is not.
+bool telemetry_start(unsigned char sync)
+{
+    unsigned char used = (telemetry_head - telemetry_tail) & (TELEMETRY_BUFFER - 1);
+
+    if(TELEMETRY_BUFFER - 1 - used < TELEMETRY_FRAME)
+    {
+        telemetry_drops ++;
+        return (false);
+    }
+
+    telemetry_buffer[telemetry_head] = sync;
+    telemetry_head = (telemetry_head + 1) & (TELEMETRY_BUFFER - 1);
+    telemetry_sum = 0;
+    return (true);
+}
+
+// Queue a telemetry frame if there is room for all of it in the ring buffer.
+bool telemetry_frame(unsigned char mode, unsigned char sensorL,
+                     unsigned char sensorR, unsigned char motorL,
+                     unsigned char motorR, unsigned int period)
+{
+    if(!telemetry_start(TELEMETRY_SYNC))
+    {
+        return (false);
+    }
+    telemetry_put(telemetry_seq ++);
+    telemetry_put(mode);
+    telemetry_put(sensorL);
+    telemetry_put(sensorR);
+    telemetry_put(motorL);
+    telemetry_put(motorR);
+    telemetry_put((unsigned char)period);
+    telemetry_put((unsigned char)(period >> 8));
+    telemetry_put(-telemetry_sum);  // Checksum - frame bytes sum to zero
+
+    TXIE = 1;                   // Start (or continue) transmitting
+    return (true);
+}
+
+// Queue a statistics frame if there is room for all of it in the ring buffer.
+bool telemetry_stats(unsigned char id, unsigned int a, unsigned int b,
+                     unsigned int c, unsigned char d)
+{
+    if(!telemetry_start(TELEMETRY_STATS))
+    {
+        return (false);
+    }
+    telemetry_put(id);
+    telemetry_put((unsigned char)a);
+    telemetry_put((unsigned char)(a >> 8));
+    telemetry_put((unsigned char)b);
+    telemetry_put((unsigned char)(b >> 8));
+    telemetry_put((unsigned char)c);
+    telemetry_put((unsigned char)(c >> 8));
+    telemetry_put(d);
+    telemetry_put(-telemetry_sum);  // Checksum - frame bytes sum to zero
+
+    TXIE = 1;                   // Start (or continue) transmitting
+    return (true);
+}
@@ -0,0 +1,116 @@
+/*==============================================================================
+ File: Telemetry.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) EUSART telemetry constant and function definitions.
+
+ Telemetry serial port:
+ Telemetry is transmitted by the EUSART on the TX pin, RB7, which is broken
+ out on header H4 (shared with SW5 and the IR demodulator input, IRIN). The
+ EUSART receiver is not used, so RB5 (H2/SW3) stays available. Connect H4 and
+ ground to the RX and GND pins of a 3.3V/5V USB-serial adapter, and decode the
+ stream with tools/chrp4-telemetry.py. The serial format is 115200 baud, 8 data
+ bits, no parity, 1 stop bit (BRGH = 1 and BRG16 = 1, SPBRG = 103, for 115385
+ baud, which is within 0.2% of 115200).
+
+ Telemetry frame format:
+ Each frame is TELEMETRY_FRAME bytes long, and holds a sync byte (0xA5), an
+ 8-bit frame sequence number, the operating mode, the left and right sensor
+ values, the left and right motor commands, the control loop period in TMR0
+ counts (2.67 us units, low byte first), and a checksum byte that makes the
+ 8-bit sum of all bytes after the sync byte equal to zero. In digital mode the
+ sensor values are the Q1 and Q2 logic levels and the motor commands are the
+ two-bit M1 and M2 output states. In analog mode the motor commands are half
+ of the signed motor speeds, as two's complement bytes (-128 to 127).
+
+ Statistics frames use the same length, and hold a sync byte (0x5A), an 8-bit
+ statistic ID, three 16-bit values (low byte first), one 8-bit value, and a
+ checksum byte. The meaning of the values depends on the ID (see Profiler.h,
+ BlackBox.h and Encoders.h).
+
+ Telemetry bandwidth and overhead:
+ Frames are copied into a TELEMETRY_BUFFER byte ring buffer and sent from the
+ EUSART transmit interrupt, so sending a frame never waits for the serial port.
+ If the buffer does not have room for a whole frame, the frame is dropped and
+ counted in telemetry_drops. Building a frame takes about 200 instruction
+ cycles, and each transmitted byte costs about 40 cycles of interrupt time:
+
+   Frame rate   Bytes/s   Link use (115200)   CPU time (12 MIPS)
+     92 Hz        920          8%                 0.5%
+    183 Hz       1830         16%                 1.0%
+    366 Hz       3660         32%                 1.9%
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the Telemetry.c
+ file.
+==============================================================================*/
+
+// Telemetry definitions
+#define TELEMETRY_SPBRG     103     // 115200 baud at 48 MHz (BRGH, BRG16)
+#define TELEMETRY_BUFFER    32      // Transmit ring buffer size (power of 2)
+#define TELEMETRY_FRAME     10      // Telemetry frame length in bytes
+#define TELEMETRY_SYNC      0xA5    // Frame start (sync) byte
+#define TELEMETRY_STATS     0x5A    // Statistics frame start (sync) byte
+
+// Telemetry statistics
+extern unsigned char telemetry_drops;   // Frames dropped (buffer full)
+
+// Prototypes for Telemetry.c functions:
+
+/**
+ * Function: void telemetry_config(void)
+ *
+ * Configure the EUSART for 115200 baud transmit-only operation on RB7/H4.
+ */
+void telemetry_config(void);
+
+/**
+ * Function: void telemetry_flush(void)
+ *
+ * Wait until every queued byte has been sent. Only for use outside of line
+ * following, e.g. to send a burst of frames at boot without dropping any.
+ */
+void telemetry_flush(void);
+
+/**
+ * Function: void telemetry_stop(void)
+ *
+ * Wait until every queued byte has been sent, then turn the EUSART off so that
+ * RB7/H4 can be used as an input (SW5 or IRIN) again.
+ */
+void telemetry_stop(void);
+
+/**
+ * Function: void telemetry_isr(void)
+ *
+ * EUSART transmit interrupt handler. Sends the next byte from the ring buffer,
+ * and disables the transmit interrupt when the buffer is empty.
+ */
+void telemetry_isr(void);
+
+/**
+ * Function: bool telemetry_frame(unsigned char mode, unsigned char sensorL,
+ *                                unsigned char sensorR, unsigned char motorL,
+ *                                unsigned char motorR, unsigned int period)
+ *
+ * Queue one telemetry frame for transmission without waiting. Returns false
+ * if the frame was dropped because the transmit buffer was too full.
+ *
+ * Example usage: telemetry_frame(mode, lightLevelLeft, lightLevelRight,
+ *                                leftSpeed / 2, rightSpeed / 2, loopPeriod);
+ */
+bool telemetry_frame(unsigned char, unsigned char, unsigned char,
+                     unsigned char, unsigned char, unsigned int);
+
+/**
+ * Function: bool telemetry_stats(unsigned char id, unsigned int a,
+ *                                unsigned int b, unsigned int c,
+ *                                unsigned char d)
+ *
+ * Queue one statistics frame for transmission without waiting. Returns false
+ * if the frame was dropped because the transmit buffer was too full.
+ *
+ * Example usage: telemetry_stats(region, min, max, mean, count);
+ */
+bool telemetry_stats(unsigned char, unsigned int, unsigned int, unsigned int,
+                     unsigned char);
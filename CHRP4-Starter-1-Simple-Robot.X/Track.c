@@ -0,0 +1,280 @@
+/*==============================================================================
+ File: Track.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) lap-learning track log functions
+
+ Functions to record a run-length log of the track's straights and corners
+ during the first lap, and to replay it on later laps to speed up on known
+ straights and brake before known corners. These functions are only compiled
+ when TRACK is defined. Include the Track.h file in your main program to call
+ these functions.
+==============================================================================*/
+
+#include    "xc.h"              // Microchip XC8 compiler include file
+#include    "stdint.h"          // Include integer definitions
+#include    "stdbool.h"         // Include Boolean (true/false) definitions
+
+#include    "Track.h"           // Include track log definitions
+
+#ifdef TRACK
+
+// Track learning states
+#define TRACK_WAIT      0           // Waiting for the first marker
+#define TRACK_RECORD    1           // Recording the first lap
+#define TRACK_REPLAY    2           // Replaying the log
+#define TRACK_FULL      3           // Log too small for the track
+
+// Log entry fields
+#define TRACK_TYPE(e)   ((e) >> 6)
+#define TRACK_LENGTH(e) ((e) & 0b00111111)
+#define TRACK_MAX       63          // Longest entry (steps)
+
+signed char track_adjust;           // Base speed adjustment
+unsigned int track_lap;             // Last lap time (updates)
+unsigned char track_laps;           // Start/finish marker crossings
+
+unsigned char track_log[TRACK_LOG_SIZE];    // Run-length segment log
+unsigned char track_count;          // Log entries used
+unsigned char track_state = TRACK_WAIT;
+unsigned char track_index;          // Replay entry
+unsigned char track_step;           // Steps travelled in the replay entry
+unsigned char track_type = TRACK_STRAIGHT;  // Current segment type
+unsigned char track_candidate = TRACK_STRAIGHT; // Possible new segment type
+unsigned int track_distance;        // Travel since the last step (speed x ticks)
+unsigned int track_units;           // Updates since the last marker
+int track_steering;                 // Steering sum since the last update
+signed char track_history[TRACK_WINDOW];    // Steering averages of recent updates
+unsigned char track_slot;           // Oldest steering average
+int track_window;                   // Sum of track_history
+unsigned int track_speed;           // Speed sum since the last update
+unsigned char track_samples;        // Samples since the last update
+bool track_marked;                  // Marker seen since the last update
+
+// Clear the log and wait for the start/finish marker.
+void track_reset(void)
+{
+    track_state = TRACK_WAIT;
+    track_count = 0;
+    track_adjust = 0;
+    track_laps = 0;
+    track_type = TRACK_STRAIGHT;
+    track_candidate = TRACK_STRAIGHT;
+    track_steering = 0;
+    track_speed = 0;
+    track_samples = 0;
+    track_marked = false;
+    for(unsigned char i = 0; i != TRACK_WINDOW; i ++)
+    {
+        track_history[i] = 0;
+    }
+    track_window = 0;
+}
+
+// Accumulate one control loop pass.
+void track_sample(int steering, unsigned char left, unsigned char right,
+                  unsigned char speed)
+{
+    track_steering += steering;
+    track_speed += speed;
+    track_samples ++;
+    if(left > TRACK_MARK && right > TRACK_MARK)
+    {
+        track_marked = true;
+    }
+}
+
+// Start a new lap at the start/finish marker.
+void track_new_lap(void)
+{
+    if(track_state == TRACK_WAIT)
+    {
+        track_state = TRACK_RECORD;
+    }
+    else
+    {
+        track_lap = track_units;
+        if(track_state == TRACK_RECORD && track_count != 0)
+        {
+            track_state = TRACK_REPLAY;
+        }
+    }
+    track_laps ++;
+    track_units = 0;
+    track_index = 0;
+    track_step = 0;
+    track_distance = 0;
+}
+
+// Add one distance step of the current segment type to the log.
+void track_record(void)
+{
+    unsigned char last = track_count - 1;
+
+    if(track_count != 0 && TRACK_TYPE(track_log[last]) == track_type &&
+       TRACK_LENGTH(track_log[last]) != TRACK_MAX)
+    {
+        track_log[last] ++;     // Lengthen the current segment
+    }
+    else if(track_count != TRACK_LOG_SIZE)
+    {
+        track_log[track_count] = (unsigned char)(track_type << 6) | 1;
+        track_count ++;
+    }
+    else
+    {
+        track_state = TRACK_FULL;
+        track_adjust = 0;
+    }
+}
+
+// Return the log entry after 'index' that has segment type 'type', skipping
+// one short segment of another type that was not seen on this lap, or
+// track_count if there is none.
+unsigned char track_next(unsigned char index, unsigned char type)
+{
+    index ++;
+    if(index != track_count && TRACK_TYPE(track_log[index]) != type &&
+       TRACK_LENGTH(track_log[index]) <= TRACK_SHORT)
+    {
+        index ++;
+    }
+    if(index != track_count && TRACK_TYPE(track_log[index]) == type)
+    {
+        return (index);
+    }
+    return (track_count);
+}
+
+// Follow the log by distance, and set the speed adjustment from the distance
+// left until the end of the current logged straight.
+void track_replay(bool step)
+{
+    unsigned char entry = track_log[track_index];
+    unsigned char next;
+    unsigned char remaining;
+
+    if(TRACK_TYPE(entry) != track_type)
+    {
+        next = track_next(track_index, track_type);
+        if(next == track_count)
+        {
+            track_adjust = 0;   // Not where the log says - don't speed up
+            return;
+        }
+        track_index = next;     // Next segment has started
+        track_step = 0;
+        entry = track_log[track_index];
+    }
+    if(step)
+    {
+        track_step ++;
+        next = track_next(track_index, track_type);
+        if(track_step >= TRACK_LENGTH(entry) && next != track_count)
+        {
+            track_index = next; // Segment continues in the next entry
+            track_step = 0;
+            entry = track_log[track_index];
+        }
+    }
+    if(track_type != TRACK_STRAIGHT)
+    {
+        track_adjust = 0;
+        return;
+    }
+
+    remaining = 0;
+    if(track_step < TRACK_LENGTH(entry))
+    {
+        remaining = TRACK_LENGTH(entry) - track_step;
+    }
+    for(unsigned char i = track_index + 1;
+        i != track_count && TRACK_TYPE(track_log[i]) == TRACK_STRAIGHT &&
+        remaining <= TRACK_BRAKE; i ++)
+    {
+        remaining += TRACK_LENGTH(track_log[i]);
+    }
+    track_adjust = (remaining > TRACK_BRAKE) ? TRACK_BOOST : -TRACK_SLOW;
+}
+
+// Classify the steering averaged over the last TRACK_WINDOW updates, which
+// cancels the PID weaving about the line, and record or replay it. The
+// steering needed for a corner grows with speed, so the straight limit is a
+// fraction of the current speed.
+void track_update(void)
+{
+    int average = 0;
+    int limit = 0;
+    unsigned int speed;
+    unsigned char type = TRACK_STRAIGHT;
+    bool step = false;
+
+    if(track_samples != 0)
+    {
+        average = track_steering / track_samples;
+        speed = track_speed / track_samples;
+        limit = (int)((speed * TRACK_STEER) >> 6) * TRACK_WINDOW;
+    }
+    if(average > 127)
+    {
+        average = 127;
+    }
+    else if(average < -127)
+    {
+        average = -127;
+    }
+    track_window += average - track_history[track_slot];
+    track_history[track_slot] = (signed char)average;
+    track_slot = (track_slot + 1) & (TRACK_WINDOW - 1);
+
+    if(track_window > limit)
+    {
+        type = TRACK_RIGHT;     // Left motor faster
+    }
+    else if(track_window < -limit)
+    {
+        type = TRACK_LEFT;
+    }
+    if(type == track_type || type != track_candidate)
+    {
+        track_candidate = type; // Ignore single-update changes
+    }
+    else
+    {
+        track_type = type;
+    }
+
+    track_distance += track_speed;  // Under one step per update
+    if(track_distance >= TRACK_STEP)
+    {
+        track_distance -= TRACK_STEP;
+        step = true;
+    }
+    track_steering = 0;
+    track_speed = 0;
+    track_samples = 0;
+    if(track_units != 0xFFFF)
+    {
+        track_units ++;
+    }
+
+    if(track_marked)
+    {
+        track_marked = false;
+        if(track_state == TRACK_WAIT || track_units >= TRACK_LAP_MIN)
+        {
+            track_new_lap();
+            return;
+        }
+    }
+    if(track_state == TRACK_RECORD && step)
+    {
+        track_record();
+    }
+    else if(track_state == TRACK_REPLAY)
+    {
+        track_replay(step);
+    }
+}
+
+#endif
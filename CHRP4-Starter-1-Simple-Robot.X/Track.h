@@ -0,0 +1,106 @@
+/*==============================================================================
+ File: Track.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) lap-learning track log constant and function definitions.
+
+ Track learning enable section:
+ Track learning code is only compiled when TRACK is defined, either by removing
+ the comment from the definition below or by adding TRACK to the project's XC8
+ compiler 'Define macros' setting. Track learning is used in analog mode, and
+ needs a start/finish marker across the track: a dark bar, wider than the line
+ and at least 20 mm long, that covers both floor sensors at the same time.
+ Both sensors are partly over a centred line and can read up to about 220
+ there, so the marker is only found when both read above TRACK_MARK.
+
+ Track log:
+ The first time the robot crosses the start/finish marker it starts recording.
+ Every TRACK_UNIT ticks, track_update() averages the PID steering correction
+ over the last TRACK_WINDOW updates, about one period of the PID weaving about
+ the line, so that the weaving averages out. The segment is a corner when the
+ average is over TRACK_STEER 64ths of the motor speed, since the steering
+ needed for a corner grows with speed. Ignoring single-update changes, the
+ segment type and the distance travelled (the average motor speed multiplied
+ by time) are added to the log. The log is a run-length list of up to
+ TRACK_LOG_SIZE bytes, each holding a segment type in its top two bits and the
+ segment length, in TRACK_STEP distance steps, in its low six bits. One step is
+ about 16 ticks (11 ms) of travel at full speed, and longer segments continue
+ in the next byte. A 128 byte log holds typically a few metres of track.
+
+ Replay:
+ After the first lap, the log is replayed by distance, so that the faster laps
+ stay in step with it. While the robot is on a logged straight, track_adjust is
+ raised by TRACK_BOOST until fewer than TRACK_BRAKE steps of the straight
+ remain, and is then lowered by TRACK_SLOW to brake before the corner. Each
+ observed change in segment type re-synchronizes the replay with the next
+ logged segment, so distance errors do not accumulate, and the boost is
+ removed whenever the observed segment does not match the log. A logged
+ segment of up to TRACK_SHORT steps, such as the wobble after the marker, may
+ not be seen again at a higher speed, so the replay skips over it when the
+ segments on either side of it match. The main program adds track_adjust to
+ the base speed. If the log fills up before the end of the first lap, the
+ track is too long to learn and track_adjust stays zero. track_lap holds the
+ time of the last lap to measure the improvement.
+
+ Function prototypes section:
+ Function prototype definitions for each of the functions in the Track.c file.
+==============================================================================*/
+
+// Track learning enable definition
+//#define TRACK
+
+// Track log definitions
+#define TRACK_LOG_SIZE  128         // Log size (bytes, one per segment)
+#define TRACK_UNIT      16          // Ticks between updates (10.9 ms)
+#define TRACK_STEP      4096        // Speed x ticks per distance step
+#define TRACK_WINDOW    16          // Steering average updates (174 ms, power of 2)
+#define TRACK_STEER     10          // Straight steering limit (64ths of the speed)
+#define TRACK_MARK      228         // Both sensors darker = start/finish marker
+#define TRACK_LAP_MIN   184         // Shortest lap (updates, 2 s)
+#define TRACK_BOOST     48          // Base speed increase on known straights
+#define TRACK_SLOW      32          // Base speed decrease before known corners
+#define TRACK_BRAKE     6           // Braking distance (steps)
+#define TRACK_SHORT     4           // Longest segment that may be missed (steps)
+
+// Track segment types
+#define TRACK_STRAIGHT  0
+#define TRACK_LEFT      1
+#define TRACK_RIGHT     2
+
+#ifdef TRACK
+
+extern signed char track_adjust;    // Base speed adjustment for the next lap
+extern unsigned int track_lap;      // Last lap time (updates)
+extern unsigned char track_laps;    // Start/finish marker crossings
+
+// Prototypes for Track.c functions:
+
+/**
+ * Function: void track_reset(void)
+ *
+ * Clear the track log and wait for the start/finish marker to start recording.
+ */
+void track_reset(void);
+
+/**
+ * Function: void track_sample(int steering, unsigned char left,
+ *                             unsigned char right, unsigned char speed)
+ *
+ * Add one control loop pass to the current update: the PID steering
+ * correction, the normalized left and right sensor levels (to find the
+ * start/finish marker), and the average motor speed.
+ *
+ * Example usage: track_sample(steering, lightLevelLeft, lightLevelRight,
+ *                     (leftSpeed + rightSpeed) >> 1);
+ */
+void track_sample(int, unsigned char, unsigned char, unsigned char);
+
+/**
+ * Function: void track_update(void)
+ *
+ * Classify and record or replay the samples since the last update, and update
+ * track_adjust. Call from a scheduler task every TRACK_UNIT ticks.
+ */
+void track_update(void);
+
+#endif
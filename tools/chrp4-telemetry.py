@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""
+CHRP4 Simple Robot telemetry decoder.
+
+Reads the binary telemetry stream sent by the robot's EUSART (see Telemetry.h)
+from a serial device, a pty, or a captured file, and writes one CSV row per
+valid frame to standard output (or to the file given with -o).
+
+Usage:
+    chrp4-telemetry.py /dev/ttyUSB0 > run.csv
+    chrp4-telemetry.py --baud 115200 /dev/ttyACM0 -o run.csv
+    chrp4-telemetry.py capture.bin -o run.csv -s profile.csv
+
+Profiler statistics frames (0x5A sync byte, sent when the firmware is built
+with PROFILE defined) are written to a second CSV file given with -s. These
+include the scheduler's active duty cycle (load) as a percentage.
+
+A firmware built with BLACKBOX defined sends its black box recording at boot
+if it was reset while line following: a statistics frame with the record
+count, the PCON reset cause, and the record period (in 683 us ticks), then the
+records as ordinary frames. These frames are written with 'blackbox' in the
+source column, and live frames with 'live'.
+
+A firmware built with (single-channel) ENCODERS defined also sends odometry
+statistics frames, which are written to the -s file with the left and right
+wheel RPM and the mean distance travelled in millimetres.
+
+Frames with a bad checksum are skipped, and the decoder re-synchronizes on the
+next sync byte. Gaps in the frame sequence numbers (dropped frames) are
+reported on standard error when the stream ends.
+"""
+
+import argparse
+import csv
+import os
+import stat
+import sys
+import termios
+
+FRAME_SYNC = 0xA5
+STATS_SYNC = 0x5A
+PROF_REGIONS = 4
+PROF_HIST_ID = 0x80
+PROF_SCHED_ID = 0x40
+BLACKBOX_ID = 0x20
+ENCODER_ID = 0x30
+POWER_PROFILES = {0: '48MHz', 1: '16MHz', 2: '500kHz'}
+FRAME_LENGTH = 10
+TMR0_COUNT_US = 32 / 12.0   # One TMR0 count is 32 instruction cycles at 12 MIPS
+MODES = {0: 'digital', 1: 'analog'}
+ANALOG = 1
+BAUD_RATES = {9600: termios.B9600, 19200: termios.B19200,
+              38400: termios.B38400, 57600: termios.B57600,
+              115200: termios.B115200, 230400: termios.B230400}
+
+
+def open_stream(path, baud):
+    """Open a serial device in raw mode at the given baud rate, or a file."""
+    fd = os.open(path, os.O_RDONLY | os.O_NOCTTY)
+    if stat.S_ISCHR(os.fstat(fd).st_mode) and os.isatty(fd):
+        attrs = termios.tcgetattr(fd)
+        attrs[0] = 0                                    # iflag: raw input
+        attrs[1] = 0                                    # oflag
+        attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL
+        attrs[3] = 0                                    # lflag: no echo/canon
+        attrs[4] = attrs[5] = BAUD_RATES[baud]
+        attrs[6][termios.VMIN] = 1
+        attrs[6][termios.VTIME] = 0
+        termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return os.fdopen(fd, 'rb', buffering=0)
+
+
+def frames(stream):
+    """Yield the sync byte and payload bytes of each valid frame."""
+    buffer = bytearray()
+    while True:
+        data = stream.read(256)
+        if not data:
+            return
+        buffer += data
+        while len(buffer) >= FRAME_LENGTH:
+            if buffer[0] not in (FRAME_SYNC, STATS_SYNC):
+                del buffer[0]
+                continue
+            frame = buffer[1:FRAME_LENGTH]
+            if sum(frame) & 0xFF != 0:
+                del buffer[0]       # Bad checksum - resync on next sync byte
+                continue
+            sync = buffer[0]
+            del buffer[:FRAME_LENGTH]
+            yield sync, frame
+
+
+def stats_row(frame):
+    """Decode a statistics frame into a CSV row."""
+    ident = frame[0]
+    a, b, c = (frame[i] | frame[i + 1] << 8 for i in (1, 3, 5))
+    if ident < PROF_REGIONS:
+        return ['region', ident, a, b, c, frame[7]]   # min, max, mean, runs
+    if ident == PROF_SCHED_ID:                        # load %, slips, profile
+        return ['scheduler', ident, round(a * 100 / 255.0, 1), b,
+                POWER_PROFILES.get(c, c), '']
+    if ident == BLACKBOX_ID:                          # records, cause, period
+        return ['blackbox', ident, a, '0x%02X' % b, c, '']
+    if ident == ENCODER_ID:                           # left RPM, right RPM, mm
+        return ['odometry', ident] + [v - 0x10000 if v & 0x8000 else v
+                                      for v in (a, b, c)] + ['']
+    first = (ident - PROF_HIST_ID) * 3
+    return ['histogram', first, a, b, c, '']         # bins first..first+2
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode CHRP4 telemetry to CSV.')
+    parser.add_argument('device', help='serial device, pty, or capture file')
+    parser.add_argument('-b', '--baud', type=int, default=115200,
+                        choices=sorted(BAUD_RATES))
+    parser.add_argument('-o', '--output', help='CSV output file (default stdout)')
+    parser.add_argument('-s', '--stats', help='statistics CSV file')
+    args = parser.parse_args()
+
+    output = open(args.output, 'w', newline='') if args.output else sys.stdout
+    writer = csv.writer(output)
+    writer.writerow(['seq', 'mode', 'sensor_left', 'sensor_right',
+                     'motor_left', 'motor_right', 'loop_period_us', 'source'])
+    stats_file = open(args.stats, 'w', newline='') if args.stats else None
+    if stats_file:
+        stats = csv.writer(stats_file)
+        stats.writerow(['kind', 'id', 'a', 'b', 'c', 'd'])
+    last_seq = None
+    lost = 0
+    blackbox = 0
+    try:
+        with open_stream(args.device, args.baud) as stream:
+            for sync, frame in frames(stream):
+                if sync == STATS_SYNC:
+                    if frame[0] == BLACKBOX_ID:
+                        blackbox = frame[1] | frame[2] << 8
+                        print('black box: %d records, reset cause 0x%02X'
+                              % (blackbox, frame[3]), file=sys.stderr)
+                    if stats_file:
+                        stats.writerow(stats_row(frame))
+                        stats_file.flush()
+                    continue
+                seq, mode, sensor_l, sensor_r, motor_l, motor_r, lo, hi = frame[:8]
+                if last_seq is not None:
+                    lost += (seq - last_seq - 1) & 0xFF
+                last_seq = seq
+                period = (hi << 8 | lo) * TMR0_COUNT_US
+                if mode == ANALOG:
+                    # Analog mode sends half of each signed motor speed
+                    motor_l = ((motor_l ^ 0x80) - 0x80) * 2
+                    motor_r = ((motor_r ^ 0x80) - 0x80) * 2
+                source = 'blackbox' if blackbox else 'live'
+                blackbox = max(blackbox - 1, 0)
+                writer.writerow([seq, MODES.get(mode, mode), sensor_l, sensor_r,
+                                 motor_l, motor_r, '%.1f' % period, source])
+                output.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if output is not sys.stdout:
+            output.close()
+        if stats_file:
+            stats_file.close()
+    if lost:
+        print('%d frame(s) lost' % lost, file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,187 @@
+/*==============================================================================
+ File: ambient.c
+ Date: October 17, 2026
+
+ CHRP4 host simulator ambient light rejection check
+
+ Measures how well synchronous sensing (see CHRP4.h) rejects ambient light.
+ The robot's floor sensors look at a white floor, then at the black line,
+ under several levels of steady and 100 Hz flickering ambient light, using
+ the phototransistor model of robot.c with its ADC noise. For each level the
+ ADC scan engine runs in raw mode and in synchronous mode with 1 to 8 pairs,
+ and the Q1 and Q2 sample sets it publishes are collected. The check prints
+ the published sets per second, the mean white and black levels and their
+ contrast, the shift of the white level from its value in the dark, and the
+ RMS noise of the white level, all in 8-bit ADC counts.
+
+ The exit status is 1 if synchronous sensing with one pair shifts the white
+ level by more than SHIFT_LIMIT counts under steady ambient light that moves
+ the raw level by more.
+
+ Usage: ambient
+==============================================================================*/
+
+#include    <stdint.h>
+#include    <stdbool.h>
+#include    <stdio.h>
+#include    <math.h>
+
+#include    "xc.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/CHRP4.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/Motors.h"
+
+#undef int
+
+#include    "robot.h"
+
+#define SETTLE_TIME     0.05        // Time before collecting sets (s)
+#define RUN_TIME        1.0         // Collection time for each case (s)
+#define WHITE           0.85        // Floor reflectance
+#define BLACK           0.08        // Line reflectance
+#define SHIFT_LIMIT     2.0         // Largest synchronous white shift (counts)
+#define MODES           5           // Raw, then 1, 2, 4 and 8 pairs
+
+typedef struct
+{
+    double ambient;                 // Ambient light (units of full D6 light)
+    double flicker;                 // 100 Hz modulation depth
+} light_t;
+
+static const light_t lights[] =
+{
+    {0, 0}, {0.05, 0}, {0.1, 0}, {0.2, 0}, {0.1, 0.5}, {0.2, 1.0}
+};
+
+static double reflectance;          // Surface under the sensors
+static unsigned char pairs;         // Synchronous sensing pairs (0 = raw)
+static double collect_start;        // Time to start collecting sets
+static long count;                  // Sample values collected
+static double sum;                  // Sum of the sample values
+static double sum_sq;               // Sum of their squares
+static long sets;                   // Sample sets collected
+
+// Phototransistor voltage at each conversion, from the D6 LED state.
+static double adc_input(uint8_t chs)
+{
+    return (robot_sensor_volts(reflectance, sim_pin(2, 0), robot_ambient(sim_time())) +
+            robot_params.noise * sim_gauss());
+}
+
+static void setup(void)
+{
+    OSC_config();
+    CHRP4_config();
+    motor_config();
+}
+
+// Start the scan engine, then collect Q1 and Q2 from each new sample set.
+static void scan(void)
+{
+    unsigned char samples[ADC_SCAN_COUNT];
+    unsigned char last;
+    unsigned char set;
+
+    ADC_scan_start();
+    D6 = 1;                     // LEDs on, as main() does after set_mode()
+    D8 = 1;
+    if(pairs)
+    {
+        ADC_scan_sync(pairs);
+    }
+    PEIE = 1;
+    GIE = 1;
+    last = ADC_scan_read(samples);
+    for(;;)
+    {
+        set = ADC_scan_read(samples);
+        if(set != last && sim_time() >= collect_start)
+        {
+            for(int s = SCAN_Q1; s <= SCAN_Q2; s ++)
+            {
+                sum += samples[s];
+                sum_sq += (double)samples[s] * samples[s];
+                count ++;
+            }
+            sets ++;
+        }
+        last = set;
+        NOP();                  // RAM-only code takes no modelled time
+    }
+}
+
+// Measure the mean and RMS noise of the published levels over a surface.
+static void measure(double surface, double *mean, double *noise, double *rate)
+{
+    reflectance = surface;
+    count = 0;
+    sum = 0;
+    sum_sq = 0;
+    sets = 0;
+    sim_power_on();
+    sim_run(setup, 1);
+    collect_start = sim_time() + SETTLE_TIME;
+    sim_run(scan, SETTLE_TIME + RUN_TIME);
+    *mean = count ? sum / count : 0;
+    *noise = count ? sqrt(fmax(sum_sq / count - *mean * *mean, 0)) : 0;
+    *rate = sets / RUN_TIME;
+}
+
+int main(void)
+{
+    static const unsigned char mode_pairs[MODES] = {0, 1, 2, 4, 8};
+    double dark_white[MODES];
+    int failures = 0;
+
+    sim_adc_input = adc_input;
+    printf("%-7s %-7s %-8s %7s %7s %7s %8s %7s %7s\n", "Ambient", "Flicker", "Mode",
+           "sets/s", "White", "Black", "Contrast", "Shift", "Noise");
+    for(unsigned l = 0; l != sizeof(lights) / sizeof(lights[0]); l ++)
+    {
+        double raw_shift = 0;
+
+        robot_params.ambient = lights[l].ambient;
+        robot_params.flicker = lights[l].flicker;
+        for(int m = 0; m != MODES; m ++)
+        {
+            double white;
+            double black;
+            double noise;
+            double black_noise;
+            double rate;
+            double shift;
+            char mode[16];
+
+            sim_seed(1 + l * MODES + m);
+            pairs = mode_pairs[m];
+            measure(WHITE, &white, &noise, &rate);
+            measure(BLACK, &black, &black_noise, &rate);
+            if(l == 0)
+            {
+                dark_white[m] = white;
+            }
+            shift = white - dark_white[m];
+            if(m == 0)
+            {
+                raw_shift = shift;
+                snprintf(mode, sizeof(mode), "raw");
+            }
+            else
+            {
+                snprintf(mode, sizeof(mode), "sync %d", pairs);
+            }
+            printf("%-7.2f %-7.1f %-8s %7.0f %7.1f %7.1f %8.1f %+7.1f %7.2f", lights[l].ambient,
+                   lights[l].flicker, mode, rate, white, black, black - white, shift, noise);
+            if(pairs == 1 && lights[l].flicker == 0 && fabs(raw_shift) > SHIFT_LIMIT &&
+               fabs(shift) > SHIFT_LIMIT)
+            {
+                printf("  FAIL");
+                failures ++;
+            }
+            printf("\n");
+        }
+    }
+    printf("\nLevels are 8-bit ADC counts (darker = higher). Shift is the change of the\n"
+           "white level from its value without ambient light.\n");
+    printf("%s\n", failures ? "FAILED" : "All checks passed");
+    return (failures != 0);
+}
@@ -0,0 +1,178 @@
+/*==============================================================================
+ File: bench.c
+ Date: October 17, 2026
+
+ CHRP4 host simulator micro-benchmark
+
+ Counts modelled instruction cycles (see sim.h) and host wall-clock time per
+ call of ADC_read_channel(), per call of the Learn More pwm_motors() function
+ and per iteration of the Learn More analog loop, and per main loop iteration
+ (sched_run() call) of the robot firmware in digital and analog modes. The
+ robot sits on a uniform grey floor, so its sensors read a steady level.
+
+ Usage: bench [iterations]
+==============================================================================*/
+
+#include    <stdint.h>
+#include    <stdbool.h>
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <time.h>
+
+#include    "xc.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/CHRP4.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/Scheduler.h"
+#include    "learn.h"
+
+int robot_main(void);               // main() of Simple-Robot.c
+void __real_sched_run(sched_task_t *, unsigned char);
+
+#undef int
+
+#define GREY_VOLTS      2.4         // Sensor voltage over the grey floor
+#define PRESS_TIME      0.1         // Mode button press time (s)
+#define PRESS_LENGTH    0.3         // Mode button press length, over a button poll (s)
+#define SETTLE_TIME     0.5         // Time to reach the main loop (s)
+#define LOOP_TIME       1.0         // Main loop measurement time (s)
+
+static int iterations = 2000;       // Calls per function benchmark
+static int button;                  // Mode selector button to press
+
+static uint64_t loop_calls;         // sched_run() calls measured
+static uint64_t loop_cycles;        // Cycles from tick to sched_run() return
+static double loop_start;           // Measurement window start (s)
+
+static double host_seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (ts.tv_sec + ts.tv_nsec * 1e-9);
+}
+
+// Grey floor, and a mode button press a moment after power-up.
+static void world(void)
+{
+    double t = sim_time();
+
+    sim_an[6] = GREY_VOLTS;
+    sim_an[7] = GREY_VOLTS;
+    sim_input[2] = (uint8_t)((sim_input[2] & ~0x0C) | (GREY_VOLTS > sim_vdd / 2 ? 0x0C : 0));
+    sim_button(button, t > PRESS_TIME && t < PRESS_TIME + PRESS_LENGTH);
+}
+
+// Time each main loop iteration from the Timer0 tick that started it.
+void __wrap_sched_run(sched_task_t *tasks, unsigned char count)
+{
+    __real_sched_run(tasks, count);
+    if(sim_time() >= loop_start)
+    {
+        loop_calls ++;
+        loop_cycles += sim_cycles - sim_t0_overflow;
+    }
+}
+
+static void adc_reads(void)
+{
+    for(int i = 0; i != iterations; i ++)
+    {
+        ADC_read_channel((i & 1) ? ANQ2 : ANQ1);
+    }
+}
+
+static void pwm_calls(void)
+{
+    for(int i = 0; i != iterations; i ++)
+    {
+        pwm_motors(128, 128);
+    }
+}
+
+static void analog_loops(void)
+{
+    for(int i = 0; i != iterations; i ++)
+    {
+        analog_loop();
+    }
+}
+
+static void robot(void)
+{
+    robot_main();
+}
+
+static void setup(void)
+{
+    OSC_config();
+    CHRP4_config();
+    ADC_config();
+}
+
+// Run a function benchmark, and print cycles and host time per call.
+static void bench(const char *name, void (*entry)(void))
+{
+    uint64_t cycles;
+    double start;
+    double host;
+
+    sim_power_on();
+    sim_run(setup, 1);
+    cycles = sim_cycles;
+    start = host_seconds();
+    sim_run(entry, 1e6);
+    host = host_seconds() - start;
+    cycles = sim_cycles - cycles;
+    printf("%-36s %9.0f %11.1f %11.0f\n", name, (double)cycles / iterations,
+           (double)cycles / iterations * sim_cycle_time() * 1e6,
+           host / iterations * 1e9);
+}
+
+// Run the firmware in a mode, and print cycles and host time per iteration.
+static void bench_loop(const char *name, int sw)
+{
+    double start;
+    double host;
+
+    sim_power_on();
+    button = sw;
+    loop_calls = 0;
+    loop_cycles = 0;
+    loop_start = SETTLE_TIME;
+    start = host_seconds();
+    sim_run(robot, SETTLE_TIME + LOOP_TIME);
+    host = host_seconds() - start;
+    if(loop_calls == 0)
+    {
+        printf("%-36s did not reach the main loop\n", name);
+        return;
+    }
+    printf("%-36s %9.0f %11.1f %11.0f  (%.0f Hz)\n", name,
+           (double)loop_cycles / loop_calls,
+           (double)loop_cycles / loop_calls * sim_cycle_time() * 1e6,
+           host / (SETTLE_TIME + LOOP_TIME) * LOOP_TIME / loop_calls * 1e9,
+           loop_calls / LOOP_TIME);
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc > 1)
+    {
+        iterations = atoi(argv[1]);
+    }
+    if(iterations <= 0)
+    {
+        fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+        return (2);
+    }
+    sim_world = world;
+    sim_quantum = 1e-3;
+
+    printf("Modelled cycles are a lower bound (see tools/sim/sim.h).\n\n");
+    printf("%-36s %9s %11s %11s\n", "", "cycles", "us", "host ns");
+    bench("ADC_read_channel()", adc_reads);
+    bench("pwm_motors() (Learn More)", pwm_calls);
+    bench("Analog loop iteration (Learn More)", analog_loops);
+    bench_loop("Digital main loop iteration", 3);
+    bench_loop("Analog main loop iteration", 4);
+    return (0);
+}
@@ -0,0 +1,211 @@
+/*==============================================================================
+ File: compcheck.c
+ Date: October 17, 2026
+
+ CHRP4 host simulator comparator line-edge check
+
+ Runs the robot firmware built with COMPARATORS defined in digital mode with
+ both floor sensors over the white floor, so that it is undoing its forward
+ motion after losing the line, and drives the Q1 and Q2 sensor voltages with
+ line edges placed between two scheduler ticks, where reading the sensors at
+ each tick would not see them.
+
+ Pulse: Q1 reads dark for PULSE_US and then light again, starting EDGE_US
+ after a tick. The pulse must still reach digital_step() through the event
+ queue, which turns the lost-line state from undoing forward motion into
+ undoing a left turn (S_LEFT, then S_UNDO_LEFT), and the last line-edge time
+ must be the time of the pulse's falling edge.
+
+ Burst: BURST_EDGES edges of Q2, BURST_US apart, overfill the event queue
+ within one tick. The burst ends with both sensors light, so the state after
+ the tick is only right (S_UNDO_RIGHT) if the queue kept the newest event in
+ place of the last one that fitted, and the last line-edge time must be the
+ time of the final edge.
+
+ The exit status is 1 if any check fails.
+
+ Usage: compcheck
+==============================================================================*/
+
+#include    <stdint.h>
+#include    <stdbool.h>
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+#include    <math.h>
+
+#include    "xc.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/Scheduler.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/Comparators.h"
+
+int robot_main(void);               // main() of Simple-Robot.c
+
+extern unsigned char digitalState;  // Digital mode state, from Simple-Robot.c
+extern unsigned int lineEdgeTime;   // Timestamp of the last line edge
+
+#undef int
+
+#define PRESS_TIME      0.1         // Digital mode button press time (s)
+#define PRESS_LENGTH    0.3         // Button press length, over a button poll (s)
+#define PULSE_TIME      0.6         // Pulse case start (s)
+#define BURST_TIME      0.8         // Burst case start (s)
+#define END_TIME        1.0         // Run length (s)
+#define EDGE_US         100.0       // First edge time after a tick (us)
+#define PULSE_US        200.0       // Pulse length (us)
+#define BURST_US        20.0        // Burst edge spacing (us)
+#define BURST_EDGES     12          // Burst edges, more than the queue holds
+#define QUANTUM         2e-6        // Sensor time step (s)
+#define SW_DIGITAL      3           // Digital mode button
+#define LIGHT_VOLTS     0.5         // Sensor voltage over the white floor
+#define DARK_VOLTS      4.5         // Sensor voltage over the line
+#define COUNT_LIMIT     2           // Largest edge time error (TMR0 counts)
+
+// Digital mode states (see the motion tables in Simple-Robot.c)
+#define S_UNDO_FWD      12
+#define S_UNDO_LEFT     16
+#define S_UNDO_RIGHT    20
+
+// Results of a case
+typedef struct
+{
+    bool done;                      // The case ran
+    uint8_t state_before;           // digitalState before the edges
+    uint8_t state_after;            // digitalState one tick after the edges
+    uint16_t edge_time;             // lineEdgeTime one tick after the edges
+    uint16_t expect_time;           // Timestamp of the last edge
+    int ticks;                      // Ticks while the edges were being sent
+} case_t;
+
+// Sensor edges of a case, in microseconds after the tick that starts it
+typedef struct
+{
+    const char *name;
+    double start;                   // Time to wait for a tick from (s)
+    int edges;                      // Edges to send
+    double first;                   // First edge (us after the tick)
+    double spacing;                 // Time from each edge to the next (us)
+    int sensor;                     // Sensor (0 = Q1, 1 = Q2)
+    uint8_t before;                 // digitalState before the edges
+    uint8_t expect;                 // digitalState after the tick
+} edges_t;
+
+static const edges_t cases[] =
+{
+    {"Pulse", PULSE_TIME, 2, EDGE_US, PULSE_US, 0, S_UNDO_FWD, S_UNDO_LEFT},
+    {"Burst", BURST_TIME, BURST_EDGES, EDGE_US, BURST_US, 1, S_UNDO_LEFT, S_UNDO_RIGHT}
+};
+#define CASES           (int)(sizeof(cases) / sizeof(cases[0]))
+
+static case_t results[CASES];
+static int current;                 // Case being run
+static double tick_start;           // Time of the tick that started the case (0 = none)
+static uint8_t start_ticks;         // sched_ticks at that tick
+static int sent;                    // Edges sent
+static bool dark[2];                // Sensor levels
+
+// Press the digital mode button, then wait for each case's tick and send its
+// edges. One tick after the last edge, keep the firmware's state.
+static void world(void)
+{
+    double t = sim_time();
+    const edges_t *c = &cases[current];
+    case_t *r = &results[current];
+    double due;
+
+    sim_button(SW_DIGITAL, t > PRESS_TIME && t < PRESS_TIME + PRESS_LENGTH);
+    if(current != CASES && t >= c->start)
+    {
+        if(tick_start == 0 && sched_ticks != start_ticks)
+        {
+            tick_start = t;     // First tick after the start time
+            start_ticks = sched_ticks;
+            r->state_before = digitalState;
+        }
+        due = tick_start + (c->first + c->spacing * sent) * 1e-6;
+        if(tick_start != 0 && sent != c->edges && t >= due)
+        {
+            dark[c->sensor] = !dark[c->sensor];
+            sent ++;
+            if(sent == c->edges)
+            {
+                r->ticks = (uint8_t)(sched_ticks - start_ticks);
+                r->expect_time = (uint16_t)(start_ticks << 8 |
+                                  (uint8_t)lround((t - tick_start) * 1e6 /
+                                                  (SCHED_TICK_US / 256.0)));
+            }
+        }
+        if(sent == c->edges && (uint8_t)(sched_ticks - start_ticks) == 2)
+        {
+            r->state_after = digitalState;  // Processed by the last tick's pass
+            r->edge_time = lineEdgeTime;
+            r->done = true;
+            current ++;
+            tick_start = 0;
+            sent = 0;
+        }
+    }
+    if(tick_start == 0)
+    {
+        start_ticks = sched_ticks;
+    }
+    sim_an[6] = dark[0] ? DARK_VOLTS : LIGHT_VOLTS;
+    sim_an[7] = dark[1] ? DARK_VOLTS : LIGHT_VOLTS;
+}
+
+static void robot(void)
+{
+    robot_main();
+}
+
+static void run(void *data)
+{
+    sim_power_on();
+    sim_hef_erase_all();
+    sim_world = world;
+    sim_quantum = QUANTUM;
+    sim_run(robot, END_TIME);
+    memcpy(data, results, sizeof(results));
+}
+
+static const char *state_name(uint8_t state)
+{
+    static const char *names[] = {"S_FWD", "S_LEFT", "S_RIGHT", "S_UNDO_FWD",
+                                  "S_UNDO_LEFT", "S_UNDO_RIGHT"};
+
+    return (state % 4 == 0 && state / 4 < 6 ? names[state / 4] : "?");
+}
+
+int main(void)
+{
+    case_t r[CASES];
+    int failures = 0;
+
+    if(!sim_isolate(run, r, sizeof(r)))
+    {
+        printf("Crashed\n");
+        return (1);
+    }
+    printf("Comparator line edges between ticks, %d event queue entries.\n\n",
+           COMP_QUEUE_SIZE);
+    printf("%-6s %5s %5s %-12s %-12s %-12s %6s %6s\n", "Case", "Edges", "Ticks",
+           "Before", "After", "Expect", "Edge", "Expect");
+    for(int c = 0; c != CASES; c ++)
+    {
+        int error = (int16_t)(r[c].edge_time - r[c].expect_time);
+        bool ok = r[c].done && r[c].ticks == 0 && r[c].state_before == cases[c].before &&
+                  r[c].state_after == cases[c].expect && abs(error) <= COUNT_LIMIT;
+
+        printf("%-6s %5d %5d %-12s %-12s %-12s %6u %6u%s\n", cases[c].name,
+               cases[c].edges, r[c].ticks, state_name(r[c].state_before),
+               state_name(r[c].state_after), state_name(cases[c].expect),
+               r[c].edge_time, r[c].expect_time, ok ? "" : "  FAIL");
+        failures += !ok;
+    }
+    if(failures)
+    {
+        printf("\n%d check(s) failed\n", failures);
+        return (1);
+    }
+    printf("\nAll checks passed\n");
+    return (0);
+}
@@ -0,0 +1,345 @@
+/*==============================================================================
+ File: enccheck.c
+ Date: October 17, 2026
+
+ CHRP4 host simulator wheel encoder check
+
+ Runs the robot firmware built with ENCODERS defined (the enccheck program),
+ or with ENCODERS and ENCODER_QUADRATURE defined (enccheck-quadrature), in
+ analog mode on a grey floor, and drives the encoder pins (RB4-RB7) with
+ encoder waveforms at set edge rates. Each edge is moved by a random timing
+ jitter of JITTER_US, as from an uneven encoder disc. The waveforms run for
+ WAVE_TIME and then stop, with the wheels left where they are.
+
+ For each case the check compares the counted distance with the injected
+ edges (it must be exact, including the direction of quadrature edges), the
+ mean measured speed with the injected rate, encoder_rpm() and encoder_mm()
+ with their expected values, and checks that the speed reads zero within
+ ENCODER_TIMEOUT of the last edge. With single-channel encoders it also
+ decodes the odometry statistics frames sent on the telemetry output (see
+ Encoders.h), and checks their RPM and distance values. It prints the RMS
+ speed noise from the jitter, and the interrupt time per edge.
+
+ The exit status is 1 if any check fails.
+
+ Usage: enccheck
+==============================================================================*/
+
+#include    <stdint.h>
+#include    <stdbool.h>
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <math.h>
+
+#include    "xc.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/Scheduler.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/Encoders.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/Telemetry.h"
+
+int robot_main(void);               // main() of Simple-Robot.c
+
+#undef int
+
+#define PRESS_TIME      0.1         // Analog mode button press time and length (s)
+#define WAVE_START      0.5         // Encoder waveform start time (s)
+#define WAVE_TIME       1.0         // Encoder waveform length (s)
+#define STOP_TIME       0.3         // Time after the waveform stops (s)
+#define SETTLE_TIME     0.1         // Time before sampling the speed (s)
+#define SAMPLE_TIME     1e-3        // Speed sample period (s)
+#define QUANTUM         2e-6        // Waveform time step (s)
+#define JITTER_US       10.0        // RMS edge timing jitter (us)
+#define SW_ANALOG       4           // Analog mode button
+#define GREY_VOLTS      2.4         // Sensor voltage
+#define SPEED_LIMIT     0.01        // Largest mean speed error (fraction), plus
+                                    // one speed unit (integer division)
+#define RPM_LIMIT       0.02        // Largest RPM error (fraction), plus one
+#define MM_LIMIT        0.01        // Largest distance error (fraction), plus one
+
+#ifdef ENCODER_QUADRATURE
+static const uint8_t wheel_pins[2] = {0b00110000, 0b11000000};
+static const uint8_t wheel_shift[2] = {4, 6};
+#else
+static const uint8_t wheel_pins[2] = {0b00010000, 0b00100000};
+#endif
+
+// Results of a case
+typedef struct
+{
+    long edges[2];                  // Injected edges (signed)
+    long distance[2];               // encoder_distance change
+    int rpm[2];                     // encoder_rpm() at the end of the waveform
+    long mm[2];                     // encoder_mm() at the end
+    double speed_sum[2];            // Sum of the speed samples
+    double speed_sq[2];             // Sum of their squares
+    long samples;                   // Speed samples
+    double stop_delay[2];           // Time from the last edge to zero speed
+    uint64_t isr_cycles;            // Interrupt cycles during the waveform
+    int frames;                     // Odometry frames received
+    int frame_rpm[2];               // Last odometry frame RPM during the waveform
+    int frame_mm;                   // Last odometry frame distance
+} case_t;
+
+static double rate[2];              // Injected edge rates (edges/s, signed)
+static case_t result;
+static long position[2];            // Edges from the starting position
+static double next_edge[2];         // Time of the next edge
+static double last_edge[2];         // Time of the last edge
+static double next_sample;          // Time of the next speed sample
+static uint64_t isr_start;          // sim_isr_cycles at the waveform start
+static long start_distance[2];      // encoder_distance at the waveform start
+static uint8_t frame[TELEMETRY_FRAME];  // Telemetry frame being received
+static int frame_bytes;
+
+// Encoder pin levels for a wheel position. Single-channel encoders toggle
+// once per counted edge, and quadrature encoders step through the Gray code
+// in the order that encoder_steps[] counts up, from both channels high.
+static uint8_t wheel_levels(int w, long p)
+{
+#ifdef ENCODER_QUADRATURE
+    static const uint8_t gray[4] = {3, 1, 0, 2};
+
+    return ((uint8_t)(gray[p & 3] << wheel_shift[w]));
+#else
+    return ((p & 1) ? 0 : wheel_pins[w]);
+#endif
+}
+
+// Collect telemetry bytes, and keep the values of each odometry frame.
+static void uart_tx(uint8_t data)
+{
+    uint8_t sum = 0;
+
+    if(frame_bytes == 0 && data != TELEMETRY_STATS && data != TELEMETRY_SYNC)
+    {
+        return;
+    }
+    frame[frame_bytes ++] = data;
+    if(frame_bytes != TELEMETRY_FRAME)
+    {
+        return;
+    }
+    frame_bytes = 0;
+    for(int i = 1; i != TELEMETRY_FRAME; i ++)
+    {
+        sum += frame[i];
+    }
+    if(frame[0] != TELEMETRY_STATS || frame[1] != ENCODER_ID || sum != 0)
+    {
+        return;
+    }
+    result.frames ++;
+    if(sim_time() < WAVE_START + WAVE_TIME)
+    {
+        result.frame_rpm[0] = (int16_t)(frame[2] | frame[3] << 8);
+        result.frame_rpm[1] = (int16_t)(frame[4] | frame[5] << 8);
+    }
+    result.frame_mm = (int16_t)(frame[6] | frame[7] << 8);
+}
+
+// Schedule the next edge of a wheel, with timing jitter.
+static void schedule(int w, double t)
+{
+    next_edge[w] = WAVE_START + (labs(position[w]) + 1) / fabs(rate[w]) +
+                   JITTER_US * 1e-6 * sim_gauss();
+    if(next_edge[w] <= t)
+    {
+        next_edge[w] = t + QUANTUM;
+    }
+}
+
+// Press the analog mode button, then drive the encoder pins and sample the
+// measured speeds.
+static void world(void)
+{
+    double t = sim_time();
+    uint8_t levels;
+
+    sim_an[6] = GREY_VOLTS;
+    sim_an[7] = GREY_VOLTS;
+    sim_button(SW_ANALOG, t > PRESS_TIME && t < 2 * PRESS_TIME);
+    levels = sim_input[1] & (uint8_t)~(wheel_pins[0] | wheel_pins[1]);
+    if(t >= WAVE_START && isr_start == 0)
+    {
+        isr_start = sim_isr_cycles;
+        for(int w = 0; w != 2; w ++)
+        {
+            start_distance[w] = encoder_distance[w];
+        }
+        for(int w = 0; w != 2; w ++)
+        {
+            if(rate[w] != 0)
+            {
+                schedule(w, t);
+            }
+        }
+    }
+    for(int w = 0; w != 2; w ++)
+    {
+        if(isr_start != 0 && rate[w] != 0 && t >= next_edge[w] &&
+           t < WAVE_START + WAVE_TIME)
+        {
+            position[w] += rate[w] > 0 ? 1 : -1;
+            last_edge[w] = t;
+            schedule(w, t);
+        }
+        levels |= wheel_levels(w, position[w]);
+        if(rate[w] != 0 && t > WAVE_START + WAVE_TIME && result.stop_delay[w] == 0 &&
+           encoder_speed[w] == 0)
+        {
+            result.stop_delay[w] = t - last_edge[w];
+        }
+    }
+    if(isr_start != 0)
+    {
+        sim_input[1] = levels;  // Quadrature encoders share the mode button pins
+    }
+
+    if(t >= next_sample && t < WAVE_START + WAVE_TIME)
+    {
+        next_sample = t + SAMPLE_TIME;
+        if(t >= WAVE_START + SETTLE_TIME)
+        {
+            for(int w = 0; w != 2; w ++)
+            {
+                result.speed_sum[w] += encoder_speed[w];
+                result.speed_sq[w] += (double)encoder_speed[w] * encoder_speed[w];
+            }
+            result.samples ++;
+        }
+    }
+    if(t >= WAVE_START + WAVE_TIME && result.isr_cycles == 0)
+    {
+        result.isr_cycles = sim_isr_cycles - isr_start;
+        for(int w = 0; w != 2; w ++)
+        {
+            result.rpm[w] = encoder_rpm((unsigned char)w);
+        }
+    }
+}
+
+static void robot(void)
+{
+    robot_main();
+}
+
+static void run(void *data)
+{
+    case_t *r = data;
+
+    sim_power_on();
+    sim_hef_erase_all();
+    sim_world = world;
+    sim_quantum = QUANTUM;
+    sim_uart_tx = uart_tx;
+    sim_run(robot, WAVE_START + WAVE_TIME + STOP_TIME);
+    for(int w = 0; w != 2; w ++)
+    {
+        result.edges[w] = position[w];
+        result.distance[w] = encoder_distance[w] - start_distance[w];
+        result.mm[w] = encoder_mm((unsigned char)w);
+    }
+    *r = result;
+}
+
+static bool near(double value, double expect, double fraction, double plus)
+{
+    return (fabs(value - expect) <= fabs(expect) * fraction + plus);
+}
+
+int main(void)
+{
+    static const double rates[][2] =
+    {
+        {0, 0},
+#ifdef ENCODER_QUADRATURE
+        {600, -600}, {3000, 1200}, {-3000, -150}, {4000, -2000}
+#else
+        {300, 600}, {1500, 3000}, {3000, 150}, {3600, 2000}
+#endif
+    };
+    double base_isr = 0;
+    int failures = 0;
+
+    printf("%s encoders, %d edges per wheel revolution, %.0f us edge jitter.\n\n",
+#ifdef ENCODER_QUADRATURE
+           "Quadrature",
+#else
+           "Single-channel",
+#endif
+           ENCODER_EDGES_REV, JITTER_US);
+    printf("%-5s %6s %8s %8s %6s %6s %6s %6s %7s %6s %6s", "Wheel", "Rate", "Edges",
+           "Counted", "Speed", "Expect", "Noise", "RPM", "Expect", "mm", "Stop");
+#ifndef ENCODER_QUADRATURE
+    printf("  %s", "Frame RPM");
+#endif
+    printf("\n");
+    for(unsigned c = 0; c != sizeof(rates) / sizeof(rates[0]); c ++)
+    {
+        case_t r = {0};
+        long edges = 0;
+        bool ok = true;
+
+        rate[0] = rates[c][0];
+        rate[1] = rates[c][1];
+        sim_seed(1 + c);
+        if(!sim_isolate(run, &r, sizeof(r)))
+        {
+            printf("Case %u crashed\n", c);
+            failures ++;
+            continue;
+        }
+        for(int w = 0; w != 2; w ++)
+        {
+            double expect_speed = rate[w] * 255 / ENCODER_MAX_RATE;
+            double expect_rpm = rate[w] * 60 / ENCODER_EDGES_REV;
+            double expect_mm = r.edges[w] * (ENCODER_WHEEL_UM / 1000.0) / ENCODER_EDGES_REV;
+            double mean = r.samples ? r.speed_sum[w] / r.samples : 0;
+            double noise = r.samples ? sqrt(fmax(r.speed_sq[w] / r.samples - mean * mean,
+                                                  0)) : 0;
+            bool wheel_ok = r.distance[w] == r.edges[w] &&
+                            near(mean, expect_speed, SPEED_LIMIT, 1) &&
+                            near(r.rpm[w], expect_rpm, RPM_LIMIT, 1) &&
+                            near(r.mm[w], expect_mm, MM_LIMIT, 1) &&
+                            (rate[w] == 0 || (r.stop_delay[w] > 0 &&
+                             r.stop_delay[w] <= ENCODER_TIMEOUT / 375000.0 +
+                             2 * ENCODER_PERIOD * 683e-6));
+
+            edges += labs(r.edges[w]);
+            printf("%-5s %6.0f %8ld %8ld %6.1f %6.1f %6.2f %6d %7.1f %6ld %5.0fms",
+                   w == ENCODER_LEFT ? "Left" : "Right", rate[w], r.edges[w],
+                   r.distance[w], mean, expect_speed, noise, r.rpm[w], expect_rpm,
+                   r.mm[w], r.stop_delay[w] * 1000);
+#ifndef ENCODER_QUADRATURE
+            printf("  %6d", r.frame_rpm[w]);
+            if(r.frames == 0 || !near(r.frame_rpm[w], expect_rpm, RPM_LIMIT, 1))
+            {
+                wheel_ok = false;
+            }
+#endif
+            printf("%s\n", wheel_ok ? "" : "  FAIL");
+            ok = ok && wheel_ok;
+        }
+#ifndef ENCODER_QUADRATURE
+        if(r.frame_mm != (r.mm[0] + r.mm[1]) / 2)
+        {
+            printf("Odometry frame distance %d mm, expected %ld mm  FAIL\n", r.frame_mm,
+                   (r.mm[0] + r.mm[1]) / 2);
+            ok = false;
+        }
+#endif
+        if(c == 0)
+        {
+            base_isr = r.isr_cycles;
+        }
+        else
+        {
+            printf("Interrupt time %.0f cycles per edge (modelled cycles, a lower bound)\n",
+                   (r.isr_cycles - base_isr) / edges);
+        }
+        failures += !ok;
+    }
+    printf("\nSpeeds are in motor speed units (%d edges/s is 255), and Stop is the time\n"
+           "from the last edge to a zero speed reading.\n", ENCODER_MAX_RATE);
+    printf("%s\n", failures ? "FAILED" : "All checks passed");
+    return (failures != 0);
+}
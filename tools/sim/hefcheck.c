@@ -0,0 +1,231 @@
+/*==============================================================================
+ File: hefcheck.c
+ Date: October 17, 2026
+
+ CHRP4 host simulator HEF parameter store check
+
+ Checks the parameter store in Params.c against the simulator's model of the
+ High-Endurance Flash. Each power cycle starts the firmware from power-up
+ with its variables at their initial values and the HEF as the previous
+ cycle left it, loads the parameters as main() does, and then saves a new
+ record with random contents.
+
+ Wear: after SAVES power cycles, each one must load the record saved by the
+ one before it (across sequence number wrap-around), and the four rows'
+ erase counts, and their write counts, must differ by no more than one.
+
+ Power loss: in each of TRIALS power cycles the power fails at a random time
+ during the save, part way through the row erase or write for most cuts
+ (see sim.h). The next power cycle must load either the record from before
+ the save or the new one, never a damaged record and never none.
+
+ The check also prints the param_load() and param_save() times. The exit
+ status is 1 if any check fails.
+
+ Usage: hefcheck [-s seed]
+==============================================================================*/
+
+#include    <stdint.h>
+#include    <stdbool.h>
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+#include    <unistd.h>
+
+#include    "xc.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/CHRP4.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/Calibration.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/Params.h"
+
+#undef int
+
+#define SAVES           400         // Wear check power cycles
+#define TRIALS          1000        // Power loss check power cycles
+
+// One power cycle, with the HEF image and wear counts carried between them
+typedef struct
+{
+    uint16_t hef[SIM_HEF_ROWS * SIM_HEF_WORDS];
+    uint32_t erases[SIM_HEF_ROWS];
+    uint32_t writes[SIM_HEF_ROWS];
+    bool save;                      // Save params after loading
+    double cut;                     // Power failure time into the save (0 = none)
+    bool loaded;                    // param_load() result
+    param_t found;                  // Record loaded
+    param_t params;                 // Record to save (as saved)
+    double load_time;               // param_load() time (s)
+    double save_time;               // param_save() time (s)
+    int result;                     // param_save() sim_run() result
+} cycle_t;
+
+static cycle_t cycle;
+static param_t *record;             // Record for load() or save()
+
+static void load(void)
+{
+    cycle.loaded = param_load(record);
+}
+
+static void save(void)
+{
+    param_save(record);
+}
+
+static void power_cycle(void *data)
+{
+    cycle_t *c = data;
+    double start;
+
+    memcpy(sim_hef, c->hef, sizeof(sim_hef));
+    memcpy(sim_hef_erases, c->erases, sizeof(sim_hef_erases));
+    memcpy(sim_hef_writes, c->writes, sizeof(sim_hef_writes));
+    sim_power_on();
+    cycle = *c;
+    record = &cycle.found;
+    sim_run(load, 1);
+    cycle.load_time = sim_time();
+    if(cycle.save)
+    {
+        record = &cycle.params;
+        start = sim_time();
+        cycle.result = sim_run(save, cycle.cut > 0 ? cycle.cut : 1);
+        cycle.save_time = sim_time() - start;
+    }
+    *c = cycle;
+    memcpy(c->hef, sim_hef, sizeof(sim_hef));
+    memcpy(c->erases, sim_hef_erases, sizeof(sim_hef_erases));
+    memcpy(c->writes, sim_hef_writes, sizeof(sim_hef_writes));
+}
+
+// Fill a record with random parameters.
+static void randomize(param_t *p)
+{
+    for(unsigned i = 0; i != sizeof(param_t); i ++)
+    {
+        ((unsigned char *)p)[i] = (unsigned char)sim_random();
+    }
+}
+
+// Return true if the counts of the rows differ by no more than one.
+static bool even(const uint32_t *count)
+{
+    uint32_t low = count[0];
+    uint32_t high = count[0];
+
+    for(int r = 1; r != SIM_HEF_ROWS; r ++)
+    {
+        low = count[r] < low ? count[r] : low;
+        high = count[r] > high ? count[r] : high;
+    }
+    return (high - low <= 1);
+}
+
+static bool run(cycle_t *c)
+{
+    if(!sim_isolate(power_cycle, c, sizeof(*c)))
+    {
+        printf("Power cycle crashed\n");
+        return (false);
+    }
+    return (true);
+}
+
+int main(int argc, char *argv[])
+{
+    static cycle_t c;
+    param_t previous;
+    double load_max = 0;
+    double save_time = 0;
+    int outcome[3] = {0};           // Old record, new record, other
+    int failures = 0;
+    int opt;
+
+    sim_seed(1);
+    while((opt = getopt(argc, argv, "s:")) != -1)
+    {
+        if(opt != 's')
+        {
+            fprintf(stderr, "usage: %s [-s seed]\n", argv[0]);
+            return (2);
+        }
+        sim_seed((uint32_t)strtoul(optarg, NULL, 0));
+    }
+    for(unsigned w = 0; w != SIM_HEF_ROWS * SIM_HEF_WORDS; w ++)
+    {
+        c.hef[w] = 0x3FFF;
+    }
+
+    // Wear: load the last record, then save a new one, SAVES times
+    c.save = true;
+    c.cut = 0;
+    for(int i = 0; i != SAVES; i ++)
+    {
+        randomize(&c.params);
+        if(!run(&c))
+        {
+            return (1);
+        }
+        if(i != 0 && (!c.loaded || memcmp(&c.found, &previous, sizeof(param_t))))
+        {
+            printf("Power cycle %d did not load the record saved before it\n", i);
+            failures ++;
+        }
+        previous = c.params;
+        save_time = c.save_time;
+        load_max = c.load_time > load_max ? c.load_time : load_max;
+    }
+    printf("Wear after %d saves (row: erases/writes):", SAVES);
+    for(int r = 0; r != SIM_HEF_ROWS; r ++)
+    {
+        printf("  %d: %u/%u", r, c.erases[r], c.writes[r]);
+    }
+    if(!even(c.erases) || !even(c.writes))
+    {
+        printf("  FAIL (uneven)");
+        failures ++;
+    }
+    printf("\nparam_load() %.0f us at most, param_save() %.2f ms (modelled cycles, a lower\n"
+           "bound for param_load())\n\n", load_max * 1e6, save_time * 1e3);
+
+    // Power loss: cut each save short, then check what the next cycle loads
+    for(int i = 0; i != TRIALS; i ++)
+    {
+        param_t old = previous;
+        param_t next;
+
+        randomize(&c.params);
+        c.save = true;
+        c.cut = save_time * sim_uniform();
+        if(!run(&c))
+        {
+            return (1);
+        }
+        next = c.params;
+        c.save = false;
+        if(!run(&c))
+        {
+            return (1);
+        }
+        if(c.loaded && !memcmp(&c.found, &old, sizeof(param_t)))
+        {
+            outcome[0] ++;
+        }
+        else if(c.loaded && !memcmp(&c.found, &next, sizeof(param_t)))
+        {
+            outcome[1] ++;
+        }
+        else
+        {
+            printf("Power loss %d at %.3f ms loaded %s\n", i, c.cut * 1e3,
+                   c.loaded ? "a damaged record" : "no record");
+            outcome[2] ++;
+            failures ++;
+        }
+        previous = c.found;
+    }
+    printf("Power loss during %d saves: %d loaded the old record, %d the new one, "
+           "%d neither\n", TRIALS, outcome[0], outcome[1], outcome[2]);
+
+    printf("\n%s\n", failures ? "FAILED" : "All checks passed");
+    return (failures != 0);
+}
@@ -0,0 +1,327 @@
+/*==============================================================================
+ File: lapsim.c
+ Date: October 17, 2026
+
+ CHRP4 host simulator lap-time suite
+
+ Runs the robot firmware round each track in digital and/or analog mode (see
+ robot.h for the robot and track models), and prints the lap times, the RMS
+ cross-track error and the number of line losses of each run. Each run starts
+ from power-up with the HEF erased, presses SW3 (digital) or SW4 (analog) to
+ start, and ends after the requested laps or when the robot leaves the track.
+ With -c, SW5 calibrates the sensors over the start of the line first.
+
+ The exit status is 1 if any run did not finish its laps, so a lap-time run
+ also works as a regression check. With -i, it is also 1 if any lap after the
+ first was not faster than the first, and each run's lap times are printed.
+ This checks the track learning of firmware built with TRACK defined.
+
+ -b sets the analog mode base speed and -g the PID gains (Q4.4, for example
+ -g 0x08,0,0 for the proportional-only steering of the original firmware, in
+ which each motor ran at the opposite sensor's level). With -w, each analog
+ run is repeated from base speed SWEEP_FIRST upwards in SWEEP_STEP steps
+ until the robot loses the line or does not finish, and the highest base
+ speed that kept the line is reported for each track.
+
+ Usage: lapsim [-l laps] [-m digital|analog|both] [-c] [-i] [-b base]
+               [-g kp,ki,kd] [-w] [-a ambient] [-f flicker] [-s seed]
+               [-o results.csv] track.csv...
+==============================================================================*/
+
+#include    <stdint.h>
+#include    <stdbool.h>
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+#include    <unistd.h>
+
+#include    "xc.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/PID.h"
+
+int robot_main(void);               // main() of Simple-Robot.c
+
+#undef int
+
+#include    "robot.h"
+
+#define PRESS_TIME      0.1         // Button press time (s)
+#define PRESS_LENGTH    0.3         // Button press length, over a button poll (s)
+#define MODE_TIME_CAL   2.5         // Mode button press time after -c (s)
+#define LAP_LIMIT       30.0        // Simulated time allowed per lap (s)
+#define SW_CAL          5           // Calibrate button
+#define SW_DIGITAL      3           // Digital mode button
+#define SW_ANALOG       4           // Analog mode button
+#define SWEEP_FIRST     96          // First base speed of a sweep
+#define SWEEP_STEP      8           // Base speed step (one SW3/SW4 key press)
+
+// Run results
+#define RUN_OK          0           // Finished without losing the line
+#define RUN_LOST        1           // Finished, but lost the line
+#define RUN_DNF         2           // Did not finish
+#define RUN_SLOWER      3           // A later lap was not faster than the first (-i)
+
+typedef struct
+{
+    int result;                     // sim_run() result
+    robot_stats_t stats;            // Robot statistics
+    double xte_rms;                 // RMS cross-track error
+} lap_run_t;
+
+static robot_track_t track;         // Track being run
+static int mode_sw;                 // Mode button to press
+static bool calibrate;              // Calibrate before starting
+static bool improve;                // Later laps must beat the first
+static double mode_time;            // Mode button press time
+static int base = PID_BASE;         // Analog mode base speed
+static int gains[3] = {PID_KP, PID_KI, PID_KD}; // PID gains
+static uint32_t seed = 1;           // Noise seed
+static FILE *csv;                   // Results file
+
+static const char *mode_names[] = {"digital", "analog"};
+static const int mode_buttons[] = {SW_DIGITAL, SW_ANALOG};
+
+// Press the buttons, then drive the robot model.
+static void world(void)
+{
+    double t = sim_time();
+
+    if(calibrate)
+    {
+        sim_button(SW_CAL, t > PRESS_TIME && t < PRESS_TIME + PRESS_LENGTH);
+    }
+    sim_button(mode_sw, t > mode_time && t < mode_time + PRESS_LENGTH);
+    robot_world();
+}
+
+static void robot(void)
+{
+    robot_main();
+}
+
+static void run(void *data)
+{
+    lap_run_t *r = data;
+
+    sim_power_on();
+    sim_hef_erase_all();
+    pid_base = (unsigned char)base; // As if set with the keys (HEF is erased)
+    pid_kp = (unsigned char)gains[0];
+    pid_ki = (unsigned char)gains[1];
+    pid_kd = (unsigned char)gains[2];
+    robot_place(&track);
+    robot_start = mode_time;
+    sim_world = world;
+    r->result = sim_run(robot, mode_time + robot_laps * LAP_LIMIT);
+    r->stats = robot_stats;
+    r->xte_rms = robot_xte_rms();
+}
+
+// Run and report one mode on the loaded track.
+static int run_mode(int m)
+{
+    lap_run_t r = {0};
+    double best = 0;
+    double total = 0;
+    int timed;
+    int slower = 0;
+    const char *result;
+    char speed[8] = "-";
+
+    mode_sw = mode_buttons[m];
+    sim_seed(seed);
+    if(!sim_isolate(run, &r, sizeof(r)))
+    {
+        r.result = -1;
+    }
+    timed = r.stats.laps < ROBOT_MAX_LAPS ? r.stats.laps : ROBOT_MAX_LAPS;
+    for(int l = 0; l != timed; l ++)
+    {
+        best = (l == 0 || r.stats.lap_time[l] < best) ? r.stats.lap_time[l] : best;
+        total += r.stats.lap_time[l];
+        if(l != 0 && r.stats.lap_time[l] >= r.stats.lap_time[0])
+        {
+            slower ++;
+        }
+    }
+    if(r.stats.laps >= robot_laps && improve && slower)
+    {
+        result = "FAIL (not faster than lap 1)";
+    }
+    else if(r.stats.laps >= robot_laps)
+    {
+        result = "ok";
+    }
+    else
+    {
+        result = r.result < 0 ? "crashed" : r.stats.off_track ? "DNF (off track)" :
+                 r.result == SIM_RESET ? "DNF (reset)" :
+                 r.stats.started ? "DNF (too slow)" : "DNF (did not start)";
+    }
+    if(mode_buttons[m] == SW_ANALOG)
+    {
+        snprintf(speed, sizeof(speed), "%d", base);
+    }
+    printf("%-14s %-8s %4s %2d/%-2d %9.3f %9.3f %9.1f %7d  %s\n", track.name,
+           mode_names[m], speed, r.stats.laps, robot_laps, best,
+           timed ? total / timed : 0, r.xte_rms * 1000, r.stats.line_losses, result);
+    if(improve && timed)
+    {
+        printf("%-28s laps (s):", "");
+        for(int l = 0; l != timed; l ++)
+        {
+            printf(" %.3f", r.stats.lap_time[l]);
+        }
+        printf("\n");
+    }
+    if(csv)
+    {
+        fprintf(csv, "%s,%s,%s,%g,%g,%u,%s,%d,%.4f,%.4f,%.2f,%d,%s\n", track.name,
+                mode_names[m], calibrate ? "calibrated" : "uncalibrated",
+                robot_params.ambient, robot_params.flicker, seed, speed, r.stats.laps,
+                best, timed ? total / timed : 0, r.xte_rms * 1000,
+                r.stats.line_losses, result);
+    }
+    if(r.stats.laps < robot_laps)
+    {
+        return (RUN_DNF);
+    }
+    if(improve && slower)
+    {
+        return (RUN_SLOWER);
+    }
+    return (r.stats.line_losses ? RUN_LOST : RUN_OK);
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "usage: %s [-l laps] [-m digital|analog|both] [-c] [-i] [-b base]\n"
+            "       [-g kp,ki,kd] [-w] [-a ambient] [-f flicker] [-s seed]\n"
+            "       [-o results.csv] track.csv...\n", name);
+    exit(2);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *csv_path = NULL;
+    int modes = 3;                  // Bit 0 digital, bit 1 analog
+    bool sweep = false;
+    int failed = 0;
+    int opt;
+
+    while((opt = getopt(argc, argv, "l:m:cib:g:wa:f:s:o:")) != -1)
+    {
+        switch(opt)
+        {
+            case 'l':
+                robot_laps = atoi(optarg);
+                break;
+            case 'm':
+                modes = !strcmp(optarg, "digital") ? 1 : !strcmp(optarg, "analog") ? 2 :
+                        !strcmp(optarg, "both") ? 3 : 0;
+                break;
+            case 'c':
+                calibrate = true;
+                break;
+            case 'i':
+                improve = true;
+                break;
+            case 'b':
+                base = (int)strtol(optarg, NULL, 0);
+                break;
+            case 'g':
+                if(sscanf(optarg, "%i,%i,%i", &gains[0], &gains[1], &gains[2]) != 3)
+                {
+                    usage(argv[0]);
+                }
+                break;
+            case 'w':
+                sweep = true;
+                break;
+            case 'a':
+                robot_params.ambient = atof(optarg);
+                break;
+            case 'f':
+                robot_params.flicker = atof(optarg);
+                break;
+            case 's':
+                seed = (uint32_t)strtoul(optarg, NULL, 0);
+                break;
+            case 'o':
+                csv_path = optarg;
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+    if(optind == argc || modes == 0 || robot_laps < 1 || robot_laps > ROBOT_MAX_LAPS ||
+       base < 0 || base > 255)
+    {
+        usage(argv[0]);
+    }
+    for(int g = 0; g != 3; g ++)
+    {
+        if(gains[g] < 0 || gains[g] > 255)
+        {
+            usage(argv[0]);
+        }
+    }
+    if(csv_path)
+    {
+        csv = fopen(csv_path, "a");
+        if(csv == NULL)
+        {
+            perror(csv_path);
+            return (2);
+        }
+    }
+    mode_time = calibrate ? MODE_TIME_CAL : PRESS_TIME;
+
+    printf("%-14s %-8s %4s %5s %9s %9s %9s %7s  %s\n", "Track", "Mode", "Base", "Laps",
+           "Best (s)", "Mean (s)", "XTE (mm)", "Losses", "Result");
+    for(int i = optind; i != argc; i ++)
+    {
+        if(!robot_track_load(argv[i], &track))
+        {
+            failed = 1;
+            continue;
+        }
+        for(int m = 0; m != 2; m ++)
+        {
+            int kept = -1;
+
+            if(!(modes & (1 << m)))
+            {
+                continue;
+            }
+            if(!sweep || mode_buttons[m] != SW_ANALOG)
+            {
+                if(run_mode(m) >= RUN_DNF)
+                {
+                    failed = 1;
+                }
+                continue;
+            }
+            for(base = SWEEP_FIRST; base <= 255 && run_mode(m) == RUN_OK;
+                base += SWEEP_STEP)
+            {
+                kept = base;
+            }
+            if(kept < 0)
+            {
+                printf("%-14s %-8s lost the line at every base speed\n", track.name,
+                       mode_names[m]);
+                failed = 1;
+            }
+            else
+            {
+                printf("%-14s %-8s highest base speed without line loss: %d\n",
+                       track.name, mode_names[m], kept);
+            }
+        }
+    }
+    if(csv)
+    {
+        fclose(csv);
+    }
+    return (failed);
+}
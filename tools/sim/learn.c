@@ -0,0 +1,53 @@
+/*==============================================================================
+ File: learn.c
+ Date: October 17, 2026
+
+ CHRP4 host simulator copies of the Learn More code
+
+ The Learn More pwm_motors() function and analog loop, from Simple-Robot.c
+ (see learn.h).
+==============================================================================*/
+
+#include    "xc.h"
+#include    "stdint.h"
+#include    "stdbool.h"
+
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/CHRP4.h"
+#include    "learn.h"
+
+void pwm_motors(unsigned char lVal, unsigned char rVal)
+{
+    for(unsigned char t = 255; t != 0; t --)
+    {
+        if(lVal == t)
+        {
+            M1A = 1;
+        }
+        if(rVal == t)
+        {
+            M2B = 1;
+        }
+        __delay_us(5);
+    }
+    // End the pulses if PWM < 255
+    if(lVal < 255)
+    {
+        M1A = 0;
+    }
+    if(rVal < 255)
+    {
+        M2B = 0;
+    }
+}
+
+void analog_loop(void)
+{
+    unsigned char lightLevelLeft = ADC_read_channel(ANQ1);
+    unsigned char lightLevelRight = ADC_read_channel(ANQ2);
+
+    pwm_motors(lightLevelRight, lightLevelLeft);
+    if(SW1 == 0)
+    {
+        RESET();
+    }
+}
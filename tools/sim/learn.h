@@ -0,0 +1,31 @@
+/*==============================================================================
+ File: learn.h
+ Date: October 17, 2026
+
+ CHRP4 host simulator copies of the Learn More code
+
+ The software pwm_motors() function and the analog loop body from the Learn
+ More section of Simple-Robot.c, which the firmware no longer compiles, kept
+ here so that the host programs can compare them with the background motor
+ drive and scheduler versions.
+==============================================================================*/
+
+#ifndef LEARN_H
+#define LEARN_H
+
+/**
+ * Function: void pwm_motors(unsigned char lVal, unsigned char rVal)
+ *
+ * Drive M1A and M2B with one 255-step software PWM period (about 1.3 ms).
+ */
+void pwm_motors(unsigned char, unsigned char);
+
+/**
+ * Function: void analog_loop(void)
+ *
+ * Run one pass of the Learn More analog line-following loop: read Q1 and Q2
+ * with ADC_read_channel(), then call pwm_motors().
+ */
+void analog_loop(void);
+
+#endif
@@ -0,0 +1,298 @@
+/*==============================================================================
+ File: power.c
+ Date: October 17, 2026
+
+ CHRP4 host simulator power model
+
+ Estimates the robot's supply current from the simulator's statistics: the
+ time spent in each clock profile and asleep, the time the ADC is on, the
+ time each LED output is lit, and (while line following) the motor current
+ of the robot model in robot.c. The CPU, ADC and LED currents below are
+ typical PIC16F1459 data sheet and CHRP4 circuit values at 5 V, so treat the
+ results as estimates for comparing firmware versions, not measurements.
+
+ The model first leaves the firmware waiting in the mode selector with no
+ button pressed, and prints the current in each stage of its power saving
+ (16 MHz, then 500 kHz after IDLE_BLINKS, then Sleep after PARK_BLINKS).
+ It then runs laps of a track in each line following mode, and prints the
+ current and charge per lap of the CPU, LEDs and motors, and the scheduler's
+ active duty cycle (sched_load).
+
+ Usage: power [-l laps] [track.csv]
+==============================================================================*/
+
+#include    <stdint.h>
+#include    <stdbool.h>
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <unistd.h>
+
+#include    "xc.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/Scheduler.h"
+
+int robot_main(void);               // main() of Simple-Robot.c
+
+#undef int
+
+#include    "robot.h"
+
+#define WAIT_TIME       40.0        // Mode selector run time (s)
+#define PRESS_TIME      0.1         // Mode button press time and length (s)
+#define LAP_LIMIT       30.0        // Simulated time allowed per lap (s)
+#define ADC_MA          0.25        // ADC conversion current (mA)
+#define GREY_VOLTS      2.4         // Sensor voltage while waiting
+
+// CPU current in each clock profile (mA)
+static const double cpu_ma[SIM_PROFILES] =
+{
+    6.0,                            // SIM_48MHZ
+    2.1,                            // SIM_16MHZ
+    0.18,                           // SIM_500KHZ
+    2.1,                            // SIM_OTHER
+    0.02                            // SIM_SLEEP (with the regulator)
+};
+
+// LED outputs and their currents
+typedef struct
+{
+    const char *name;
+    uint8_t port;
+    uint8_t bit;
+    bool active_low;
+    double ma;
+} led_t;
+
+static const led_t leds[] =
+{
+    {"D1", 0, 5, true, 3.0},        // RUN LED (RA5)
+    {"D2", 2, 4, false, 3.0},       // Motor indicator LEDs (RC4-RC7)
+    {"D3", 2, 5, false, 3.0},
+    {"D4", 2, 6, false, 3.0},
+    {"D5", 2, 7, false, 3.0},
+    {"D6", 2, 0, false, 25.0},      // Line sensor LED (RC0)
+};
+#define LEDS    (sizeof(leds) / sizeof(leds[0]))
+
+// Simulator statistics at one moment
+typedef struct
+{
+    double time;
+    double profile[SIM_PROFILES];
+    double high[LEDS];
+    double adc;
+    double motor;
+} snapshot_t;
+
+// Charge drawn between two snapshots (mA s) and the time between them
+typedef struct
+{
+    double time;
+    double cpu;
+    double adc;
+    double leds;
+    double motors;
+} charge_t;
+
+// Results of a lap run
+typedef struct
+{
+    bool finished;
+    int laps;
+    double lap_time;                // Mean lap time (s)
+    charge_t charge;                // Charge while line following
+    unsigned char load;             // sched_load at the end
+} lap_result_t;
+
+static robot_track_t track;
+static int laps = 3;
+static int mode_sw;                 // Mode button to press
+static snapshot_t marks[2];         // Snapshots at the mode selector's clock
+static int mark_count;              // changes, or at the start of line following
+
+static void take(snapshot_t *s)
+{
+    s->time = sim_time();
+    for(int p = 0; p != SIM_PROFILES; p ++)
+    {
+        s->profile[p] = sim_profile_time[p];
+    }
+    for(unsigned i = 0; i != LEDS; i ++)
+    {
+        s->high[i] = sim_high_time[leds[i].port][leds[i].bit];
+    }
+    s->adc = sim_adc_on_time;
+    s->motor = robot_stats.motor_charge;
+}
+
+static charge_t charge(const snapshot_t *a, const snapshot_t *b)
+{
+    charge_t c = {b->time - a->time, 0, 0, 0, 0};
+
+    for(int p = 0; p != SIM_PROFILES; p ++)
+    {
+        c.cpu += (b->profile[p] - a->profile[p]) * cpu_ma[p];
+    }
+    for(unsigned i = 0; i != LEDS; i ++)
+    {
+        double high = b->high[i] - a->high[i];
+
+        c.leds += (leds[i].active_low ? c.time - high : high) * leds[i].ma;
+    }
+    c.adc = (b->adc - a->adc) * ADC_MA;
+    c.motors = (b->motor - a->motor) * 1000;
+    return (c);
+}
+
+static double total(const charge_t *c)
+{
+    return (c->cpu + c->adc + c->leds + c->motors);
+}
+
+static void robot(void)
+{
+    robot_main();
+}
+
+// Mode selector: a grey floor, no buttons, and snapshots when it slows to
+// 500 kHz and when it parks in Sleep.
+static void wait_world(void)
+{
+    sim_an[6] = GREY_VOLTS;
+    sim_an[7] = GREY_VOLTS;
+    if(mark_count < 2 && sim_profile_time[mark_count == 0 ? SIM_500KHZ : SIM_SLEEP] > 0)
+    {
+        take(&marks[mark_count ++]);
+    }
+}
+
+static void wait_run(void *data)
+{
+    charge_t *phases = data;
+    snapshot_t start;
+    snapshot_t end;
+
+    sim_power_on();
+    sim_hef_erase_all();
+    sim_world = wait_world;
+    sim_quantum = 1e-3;
+    take(&start);
+    sim_run(robot, WAIT_TIME);
+    take(&end);
+    if(mark_count != 2)
+    {
+        fprintf(stderr, "The mode selector did not reach 500 kHz and Sleep\n");
+        exit(1);
+    }
+    phases[0] = charge(&start, &marks[0]);
+    phases[1] = charge(&marks[0], &marks[1]);
+    phases[2] = charge(&marks[1], &end);
+}
+
+// Line following: press the mode button, then drive the robot model, and
+// take a snapshot when the robot starts moving.
+static void lap_world(void)
+{
+    double t = sim_time();
+
+    sim_button(mode_sw, t > PRESS_TIME && t < 2 * PRESS_TIME);
+    robot_world();
+    if(mark_count == 0 && robot_stats.started)
+    {
+        take(&marks[mark_count ++]);
+    }
+}
+
+static void lap_run(void *data)
+{
+    lap_result_t *r = data;
+    snapshot_t end;
+
+    sim_power_on();
+    sim_hef_erase_all();
+    robot_place(&track);
+    robot_laps = laps;
+    robot_start = PRESS_TIME;
+    sim_world = lap_world;
+    sim_run(robot, PRESS_TIME + laps * LAP_LIMIT);
+    take(&end);
+    r->laps = robot_stats.laps;
+    r->finished = robot_stats.laps >= laps && mark_count != 0;
+    if(r->finished)
+    {
+        r->charge = charge(&marks[0], &end);
+        r->lap_time = r->charge.time / laps;
+    }
+    r->load = sched_load;
+}
+
+static void print_row(const char *name, const charge_t *c)
+{
+    printf("%-22s %8.1f %8.2f %8.2f %8.2f %8.2f %8.2f\n", name, c->time, c->cpu / c->time,
+           c->adc / c->time, c->leds / c->time, c->motors / c->time, total(c) / c->time);
+}
+
+int main(int argc, char *argv[])
+{
+    const char *path = "tracks/oval.csv";
+    static const char *mode_names[] = {"Digital", "Analog"};
+    static const int mode_buttons[] = {3, 4};
+    charge_t phases[3];
+    double stay;
+    int failed = 0;
+    int opt;
+
+    while((opt = getopt(argc, argv, "l:")) != -1)
+    {
+        if(opt != 'l' || (laps = atoi(optarg)) < 1 || laps > ROBOT_MAX_LAPS)
+        {
+            fprintf(stderr, "usage: %s [-l laps] [track.csv]\n", argv[0]);
+            return (2);
+        }
+    }
+    if(optind < argc)
+    {
+        path = argv[optind];
+    }
+    if(!robot_track_load(path, &track))
+    {
+        return (2);
+    }
+
+    printf("Estimated supply current (mA) from typical data sheet values.\n\n");
+    printf("%-22s %8s %8s %8s %8s %8s %8s\n", "Mode selector, idle", "Time (s)", "CPU",
+           "ADC", "LEDs", "Motors", "Total");
+    if(!sim_isolate(wait_run, phases, sizeof(phases)))
+    {
+        return (1);
+    }
+    print_row("16 MHz", &phases[0]);
+    print_row("500 kHz", &phases[1]);
+    print_row("Sleep (parked)", &phases[2]);
+    stay = (total(&phases[1]) + (cpu_ma[SIM_16MHZ] - cpu_ma[SIM_500KHZ]) * phases[1].time) /
+           phases[1].time;
+    printf("Waiting at 16 MHz instead of 500 kHz would draw %.2f mA (%.0f%% more).\n\n",
+           stay, 100 * (stay * phases[1].time / total(&phases[1]) - 1));
+
+    printf("%-22s %8s %8s %8s %8s %8s %8s %9s %6s\n", "Line following", "Lap (s)", "CPU",
+           "ADC", "LEDs", "Motors", "Total", "mAh/lap", "Load");
+    for(int m = 0; m != 2; m ++)
+    {
+        lap_result_t r = {0};
+
+        mode_sw = mode_buttons[m];
+        if(!sim_isolate(lap_run, &r, sizeof(r)) || !r.finished)
+        {
+            printf("%-22s did not finish %d laps of %s\n", mode_names[m], laps, track.name);
+            failed = 1;
+            continue;
+        }
+        printf("%-22s %8.2f %8.2f %8.2f %8.2f %8.2f %8.2f %9.4f %5.1f%%\n", mode_names[m],
+               r.lap_time, r.charge.cpu / r.charge.time, r.charge.adc / r.charge.time,
+               r.charge.leds / r.charge.time, r.charge.motors / r.charge.time,
+               total(&r.charge) / r.charge.time, total(&r.charge) / 3600 / laps,
+               100.0 * r.load / 255);
+    }
+    printf("\nLoad is the scheduler's active duty cycle, from modelled cycles (a lower\n"
+           "bound), on %s.\n", track.name);
+    return (failed);
+}
@@ -0,0 +1,276 @@
+/*==============================================================================
+ File: pwmcheck.c
+ Date: October 17, 2026
+
+ CHRP4 host simulator background motor drive check
+
+ Checks the motor drive in Motors.c at the register level. After each
+ motor_drive(), motor_brake() or motor_coast() call, the levels of the four
+ motor pins (RC4-RC7) are sampled once per Timer2 count for several PWM
+ periods, and each motor's time in the drive, reverse, brake and coast states
+ is compared with the requested speed: forward drive must take speed/255 of
+ each period and brake for the rest, and reverse drive must take speed/255
+ and coast for the rest, each within one duty step. The LATC bits of the
+ floor sensor LEDs must be left as they were. The supply compensation is
+ checked the same way at a low supply voltage.
+
+ Finally the control loop rate of the Learn More analog loop, which runs the
+ software pwm_motors() once per pass, is compared with the same loop using
+ motor_set_speed().
+
+ The exit status is 1 if any check fails.
+
+ Usage: pwmcheck
+==============================================================================*/
+
+#include    <stdint.h>
+#include    <stdbool.h>
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <math.h>
+
+#include    "xc.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/CHRP4.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/Motors.h"
+#include    "learn.h"
+
+#undef int
+
+#define TMR2_CYCLES     16          // Instruction cycles per Timer2 count
+#define PERIODS_SETTLE  2           // PWM periods before measuring
+#define PERIODS         8           // PWM periods measured
+#define TOLERANCE       (1.0 / 255) // Largest duty error (one step)
+#define LED_PATTERN     0b00000101  // LATC sensor LED bits to preserve
+#define LOOPS           200         // Loop rate iterations
+
+// Motor states, from the forward and reverse pin levels
+enum {COAST, FWD, REV, BRAKE, STATES};
+
+static const char *state_names[] = {"coast", "fwd", "rev", "brake"};
+
+static int speed[2];                // Requested left and right speeds
+static void (*action)(void);        // Call that sets the motors
+static double measure_start;        // Start of the measured periods
+static long samples;                // Pin samples taken
+static long state_count[2][STATES]; // Samples in each motor state
+static int failures;
+
+static void drive(void)
+{
+    motor_drive(speed[0], speed[1]);
+}
+
+static void brake(void)
+{
+    motor_brake();
+}
+
+static void coast(void)
+{
+    motor_coast();
+}
+
+// Sample the motor pins.
+static void world(void)
+{
+    static const uint8_t fwd_bit[2] = {MOTOR_L_SWAP ? MOTOR_M1B_BIT : MOTOR_M1A_BIT,
+                                       MOTOR_R_SWAP ? MOTOR_M2A_BIT : MOTOR_M2B_BIT};
+    static const uint8_t rev_bit[2] = {MOTOR_L_SWAP ? MOTOR_M1A_BIT : MOTOR_M1B_BIT,
+                                       MOTOR_R_SWAP ? MOTOR_M2B_BIT : MOTOR_M2A_BIT};
+
+    if(sim_time() < measure_start)
+    {
+        return;
+    }
+    for(int m = 0; m != 2; m ++)
+    {
+        state_count[m][sim_pin(2, fwd_bit[m]) | sim_pin(2, rev_bit[m]) << 1] ++;
+    }
+    samples ++;
+}
+
+// Call the motor function, then idle until the measurement is done.
+static void run(void)
+{
+    action();
+    for(;;)
+    {
+        NOP();
+    }
+}
+
+// Measure the motor states after an action, and compare each motor's state
+// fractions with the expected ones.
+static void measure(const char *name, void (*call)(void), const double expect[2][STATES])
+{
+    double period = (MOTOR_PWM_PR2 + 1) * TMR2_CYCLES * sim_cycle_time();
+    bool ok = true;
+
+    action = call;
+    samples = 0;
+    for(int m = 0; m != 2; m ++)
+    {
+        for(int s = 0; s != STATES; s ++)
+        {
+            state_count[m][s] = 0;
+        }
+    }
+    LATC = (uint8_t)((LATC & ~MOTOR_SENSOR_PINS) | LED_PATTERN);
+    sim_quantum = TMR2_CYCLES * sim_cycle_time();
+    measure_start = sim_time() + PERIODS_SETTLE * period;
+    sim_run(run, (PERIODS_SETTLE + PERIODS) * period);
+
+    printf("%-34s", name);
+    for(int m = 0; m != 2; m ++)
+    {
+        printf(" %s", m == 0 ? "L" : " R");
+        for(int s = 0; s != STATES; s ++)
+        {
+            double fraction = (double)state_count[m][s] / samples;
+
+            if(fraction >= 0.0005)
+            {
+                printf(" %s %.3f", state_names[s], fraction);
+            }
+            if(fabs(fraction - expect[m][s]) > TOLERANCE)
+            {
+                ok = false;
+            }
+        }
+    }
+    if((LATC & 0x0F) != LED_PATTERN)
+    {
+        printf("  (LATC 0-3 changed to %X)", LATC & 0x0F);
+        ok = false;
+    }
+    printf("%s\n", ok ? "" : "  FAIL");
+    failures += !ok;
+}
+
+// Expected state fractions for a signed speed at a duty cycle scale.
+static void expect_speed(int s, double scale, double *expect)
+{
+    double duty = fmin(fmin(abs(s), 255) * scale / 255, 1.0);
+
+    for(int i = 0; i != STATES; i ++)
+    {
+        expect[i] = 0;
+    }
+    if(s >= 0)
+    {
+        expect[FWD] = duty;
+        expect[BRAKE] = 1 - duty;
+    }
+    else
+    {
+        expect[REV] = duty;
+        expect[COAST] = 1 - duty;
+    }
+}
+
+static void check_drive(int left, int right, double scale)
+{
+    double expect[2][STATES];
+    char name[40];
+
+    speed[0] = left;
+    speed[1] = right;
+    expect_speed(left, scale, expect[0]);
+    expect_speed(right, scale, expect[1]);
+    snprintf(name, sizeof(name), "motor_drive(%d, %d)", left, right);
+    measure(name, drive, expect);
+}
+
+static void check_hold(const char *name, void (*call)(void), int state)
+{
+    double expect[2][STATES] = {{0}};
+
+    expect[0][state] = 1;
+    expect[1][state] = 1;
+    measure(name, call, expect);
+}
+
+static void setup(void)
+{
+    OSC_config();
+    CHRP4_config();
+    ADC_config();
+    motor_config();
+}
+
+static void supply(void)
+{
+    // FVR reading at a 4.0 V supply, repeated to settle the filter
+    for(int i = 0; i != 32; i ++)
+    {
+        motor_supply((unsigned int)lround(1023.0 * ADC_FVR_MV / 4000));
+    }
+}
+
+static void learn_loops(void)
+{
+    for(int i = 0; i != LOOPS; i ++)
+    {
+        analog_loop();
+    }
+}
+
+static void drive_loops(void)
+{
+    for(int i = 0; i != LOOPS; i ++)
+    {
+        unsigned char lightLevelLeft = ADC_read_channel(ANQ1);
+        unsigned char lightLevelRight = ADC_read_channel(ANQ2);
+
+        motor_set_speed(lightLevelRight, lightLevelLeft);
+    }
+}
+
+// Return the loop rate of a loop function (passes per second).
+static double loop_rate(void (*loops)(void))
+{
+    double start = sim_time();
+
+    sim_world = NULL;
+    sim_run(loops, 10);
+    return (LOOPS / (sim_time() - start));
+}
+
+int main(void)
+{
+    static const int speeds[][2] =
+    {
+        {0, 0}, {1, 254}, {128, 64}, {255, 255}, {200, -200}, {-1, -255}, {-128, 30}
+    };
+    double learn_rate;
+    double drive_rate;
+
+    sim_power_on();
+    sim_run(setup, 1);
+    sim_world = world;
+
+    printf("Motor pin states (fraction of each PWM period):\n");
+    for(unsigned i = 0; i != sizeof(speeds) / sizeof(speeds[0]); i ++)
+    {
+        check_drive(speeds[i][0], speeds[i][1], 1.0);
+    }
+    check_hold("motor_brake()", brake, BRAKE);
+    check_hold("motor_coast()", coast, COAST);
+
+    printf("\nAt a 4.0 V supply (speeds scaled by 4.5 V / 4.0 V):\n");
+    sim_run(supply, 1);
+    check_drive(100, -100, MOTOR_VNOM_MV / 4000.0);
+    check_drive(240, 240, MOTOR_VNOM_MV / 4000.0);
+
+    printf("\nAnalog control loop rate (modelled cycles, a lower bound):\n");
+    sim_power_on();
+    sim_run(setup, 1);
+    learn_rate = loop_rate(learn_loops);
+    drive_rate = loop_rate(drive_loops);
+    printf("%-34s %8.0f Hz\n", "pwm_motors() (Learn More)", learn_rate);
+    printf("%-34s %8.0f Hz  (%.0fx)\n", "motor_set_speed()", drive_rate,
+           drive_rate / learn_rate);
+
+    printf("\n%s\n", failures ? "FAILED" : "All checks passed");
+    return (failures != 0);
+}
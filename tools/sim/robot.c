@@ -0,0 +1,370 @@
+/*==============================================================================
+ File: robot.c
+ Date: October 17, 2026
+
+ CHRP4 host simulator robot and track model functions
+
+ Functions to load tracks, and to move the robot and set its sensor inputs
+ from the firmware's motor outputs in simulated time (see robot.h).
+==============================================================================*/
+
+#include    <stdint.h>
+#include    <stdbool.h>
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+#include    <math.h>
+
+#include    "xc.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/Motors.h"
+
+#undef int
+
+#include    "robot.h"
+
+#define VDD_NOMINAL     4.5         // Supply voltage for speed_max (V)
+#define SEARCH_WINDOW   24          // Track segments searched each way
+#define SENSOR_Q1       6           // Q1 ADC channel (AN6, RC2)
+#define SENSOR_Q2       7           // Q2 ADC channel (AN7, RC3)
+
+robot_params_t robot_params =
+{
+    .wheelbase = 0.095,
+    .sensor_ahead = 0.045,
+    .sensor_spacing = 0.014,
+    .spot_radius = 0.004,
+    .speed_max = 0.45,
+    .motor_tau = 0.08,
+    .coast_tau = 0.05,
+    .right_gain = 0.95,
+    .motor_ohms = 6.0,
+    .motor_idle = 0.07,
+    .sensor_gain = 0.82,
+    .sensor_tau = 30e-6,
+    .ambient = 0,
+    .flicker = 0,
+    .noise = 0.01,
+};
+robot_stats_t robot_stats;
+int robot_laps = 3;
+double robot_start;
+
+static const robot_track_t *track;  // Track being driven
+static double pos_x;                // Axle centre position
+static double pos_y;
+static double heading;              // Direction of travel (radians)
+static double speed[2];             // Left and right wheel speeds
+static double volts[2];             // Q1 and Q2 voltages
+static int hint[3];                 // Track search start (midpoint, Q1, Q2)
+static double last_s;               // Last distance along the line
+static double off_time;             // Time off the track
+static bool lost;                   // Both sensors have lost the line
+
+bool robot_track_load(const char *path, robot_track_t *t)
+{
+    FILE *file = fopen(path, "r");
+    const char *name = strrchr(path, '/');
+    char line[256];
+    double value;
+    double x;
+    double y;
+    double w;
+
+    if(file == NULL)
+    {
+        perror(path);
+        return (false);
+    }
+    memset(t, 0, sizeof(*t));
+    snprintf(t->name, sizeof(t->name), "%s", name ? name + 1 : path);
+    t->line_width = 0.019;
+    t->line_reflectance = 0.08;
+    t->floor_reflectance = 0.85;
+    while(fgets(line, sizeof(line), file))
+    {
+        if(sscanf(line, "# line_width %lf", &value) == 1)
+        {
+            t->line_width = value / 1000;
+        }
+        else if(sscanf(line, "# line_reflectance %lf", &value) == 1)
+        {
+            t->line_reflectance = value;
+        }
+        else if(sscanf(line, "# floor_reflectance %lf", &value) == 1)
+        {
+            t->floor_reflectance = value;
+        }
+        else if(sscanf(line, "# marker %lf %lf %lf", &x, &y, &w) == 3)
+        {
+            t->marker_at = x / 1000;
+            t->marker_length = y / 1000;
+            t->marker_width = w / 1000;
+        }
+        else if(line[0] != '#' && sscanf(line, "%lf,%lf", &x, &y) == 2)
+        {
+            if(t->points == ROBOT_MAX_POINTS)
+            {
+                fprintf(stderr, "%s: more than %d points\n", path, ROBOT_MAX_POINTS);
+                fclose(file);
+                return (false);
+            }
+            t->x[t->points] = x / 1000;
+            t->y[t->points] = y / 1000;
+            t->points ++;
+        }
+    }
+    fclose(file);
+    if(t->points < 3)
+    {
+        fprintf(stderr, "%s: a track needs at least 3 points\n", path);
+        return (false);
+    }
+    for(int i = 0; i != t->points; i ++)
+    {
+        int j = (i + 1) % t->points;
+
+        t->s[i + 1] = t->s[i] + hypot(t->x[j] - t->x[i], t->y[j] - t->y[i]);
+    }
+    t->length = t->s[t->points];
+    return (true);
+}
+
+// Find the nearest point on the line to (px, py), searching near *start first
+// and the whole track if that is not close. Returns the signed distance
+// (positive to the left of the direction of travel) and the distance along
+// the line in *along.
+static double nearest(double px, double py, int *start, double *along)
+{
+    double best = INFINITY;
+    double sign = 1;
+    int n = track->points;
+    int from = *start - SEARCH_WINDOW;
+    int count = 2 * SEARCH_WINDOW + 1;
+
+    for(int pass = 0; pass != 2; pass ++)
+    {
+        for(int k = 0; k != count; k ++)
+        {
+            int i = ((from + k) % n + n) % n;
+            int j = (i + 1) % n;
+            double dx = track->x[j] - track->x[i];
+            double dy = track->y[j] - track->y[i];
+            double len2 = dx * dx + dy * dy;
+            double u = ((px - track->x[i]) * dx + (py - track->y[i]) * dy) / len2;
+            double d;
+
+            u = u < 0 ? 0 : u > 1 ? 1 : u;
+            d = hypot(px - track->x[i] - u * dx, py - track->y[i] - u * dy);
+            if(d < best)
+            {
+                best = d;
+                sign = dx * (py - track->y[i]) - dy * (px - track->x[i]) < 0 ? -1 : 1;
+                *start = i;
+                *along = track->s[i] + u * (track->s[i + 1] - track->s[i]);
+            }
+        }
+        if(best < ROBOT_OFF_TRACK / 2)
+        {
+            break;
+        }
+        from = 0;                   // Lost - search everything
+        count = n;
+    }
+    return (sign * best);
+}
+
+// Fraction of the width of a sensor spot, centred distance from the centre of
+// a stripe, that is over the stripe.
+static double overlap(double distance, double width)
+{
+    double r = robot_params.spot_radius;
+    double w = width / 2;
+    double d = fabs(distance);
+    double over = fmin(d + r, w) - fmax(d - r, -w);
+
+    return (over <= 0 ? 0 : fmin(over / (2 * r), 1));
+}
+
+// Fraction of a sensor spot over the line or the start/finish marker.
+static double coverage(double distance, double along)
+{
+    double line = overlap(distance, track->line_width);
+    double d = along - track->marker_at - track->marker_length / 2;
+    double marker;
+
+    if(track->marker_length == 0)
+    {
+        return (line);
+    }
+    d -= track->length * floor(d / track->length + 0.5);
+    marker = overlap(d, track->marker_length) * overlap(distance, track->marker_width);
+    return (fmax(line, marker));
+}
+
+double robot_sensor_volts(double reflectance, bool led, double ambient)
+{
+    double level = 1 - robot_params.sensor_gain * ((led ? reflectance : 0) + ambient);
+
+    return (sim_vdd * (level < 0.02 ? 0.02 : level));
+}
+
+double robot_ambient(double t)
+{
+    return (robot_params.ambient * (1 + robot_params.flicker * cos(2 * M_PI * 100 * t)));
+}
+
+double robot_xte_rms(void)
+{
+    return (robot_stats.xte_samples ? sqrt(robot_stats.xte_sum / robot_stats.xte_samples) : 0);
+}
+
+static double adc_input(uint8_t chs)
+{
+    return (sim_an[chs] + robot_params.noise * sim_gauss());
+}
+
+void robot_place(const robot_track_t *t)
+{
+    track = t;
+    pos_x = t->x[0];
+    pos_y = t->y[0];
+    heading = atan2(t->y[1] - t->y[0], t->x[1] - t->x[0]);
+    speed[0] = 0;
+    speed[1] = 0;
+    volts[0] = sim_vdd;
+    volts[1] = sim_vdd;
+    hint[0] = hint[1] = hint[2] = 0;
+    last_s = 0;
+    off_time = 0;
+    lost = false;
+    memset(&robot_stats, 0, sizeof(robot_stats));
+    sim_world = robot_world;
+    sim_quantum = ROBOT_QUANTUM;
+    sim_adc_input = adc_input;
+}
+
+// Update a wheel speed from the average levels of its motor driver inputs,
+// and return the supply current.
+static double motor(int m, uint8_t fwd_bit, uint8_t rev_bit, double dt)
+{
+    const robot_params_t *p = &robot_params;
+    double a = sim_pin_duty(2, fwd_bit);
+    double b = sim_pin_duty(2, rev_bit);
+    double fwd = a * (1 - b);
+    double rev = b * (1 - a);
+    double brake = a * b;
+    double coast = (1 - a) * (1 - b);
+    double full = p->speed_max * sim_vdd / VDD_NOMINAL * (m == 1 ? p->right_gain : 1);
+    double emf = VDD_NOMINAL * speed[m] / p->speed_max;
+    double v = speed[m];
+
+    v += (((fwd - rev) * full - (fwd + rev + brake) * speed[m]) / p->motor_tau -
+          coast * speed[m] / p->coast_tau) * dt;
+    speed[m] = v;
+    return (fwd * fmax(0, (sim_vdd - emf) / p->motor_ohms + p->motor_idle) +
+            rev * fmax(0, (sim_vdd + emf) / p->motor_ohms + p->motor_idle));
+}
+
+void robot_world(void)
+{
+    const robot_params_t *p = &robot_params;
+    robot_stats_t *st = &robot_stats;
+    double dt = sim_quantum;
+    double t = sim_time();
+    double current;
+    double v;
+    double w;
+    double fx;
+    double fy;
+    double mid;
+    double along;
+    double ds;
+    double cover[2];
+    bool led = sim_pin(2, 0);       // D6
+    double decay = 1 - exp(-dt / p->sensor_tau);
+
+    // Motors and movement
+    current = motor(0, MOTOR_L_SWAP ? MOTOR_M1B_BIT : MOTOR_M1A_BIT,
+                    MOTOR_L_SWAP ? MOTOR_M1A_BIT : MOTOR_M1B_BIT, dt);
+    current += motor(1, MOTOR_R_SWAP ? MOTOR_M2A_BIT : MOTOR_M2B_BIT,
+                     MOTOR_R_SWAP ? MOTOR_M2B_BIT : MOTOR_M2A_BIT, dt);
+    v = (speed[0] + speed[1]) / 2;
+    w = (speed[1] - speed[0]) / p->wheelbase;
+    heading += w * dt;
+    pos_x += v * cos(heading) * dt;
+    pos_y += v * sin(heading) * dt;
+
+    // Sensors
+    fx = pos_x + p->sensor_ahead * cos(heading);
+    fy = pos_y + p->sensor_ahead * sin(heading);
+    for(int s = 0; s != 2; s ++)
+    {
+        double side = (s == 0 ? 0.5 : -0.5) * p->sensor_spacing;
+        double sx = fx - side * sin(heading);
+        double sy = fy + side * cos(heading);
+        double d = nearest(sx, sy, &hint[1 + s], &along);
+        double r;
+
+        cover[s] = coverage(d, along);
+        r = track->floor_reflectance +
+            (track->line_reflectance - track->floor_reflectance) * cover[s];
+        volts[s] += (robot_sensor_volts(r, led, robot_ambient(t)) - volts[s]) * decay;
+    }
+    sim_an[SENSOR_Q1] = volts[0];
+    sim_an[SENSOR_Q2] = volts[1];
+    sim_input[2] = (uint8_t)((sim_input[2] & ~0x0C) | (volts[0] > sim_vdd / 2 ? 0x04 : 0) |
+                             (volts[1] > sim_vdd / 2 ? 0x08 : 0));
+
+    // Statistics
+    mid = nearest(fx, fy, &hint[0], &along);
+    if(!st->started)
+    {
+        last_s = along;
+        if(t < robot_start || fabs(v) < 0.01)
+        {
+            return;
+        }
+        st->started = true;
+        st->start_time = t;
+    }
+    st->motor_charge += current * dt;
+    ds = along - last_s;
+    ds -= track->length * floor(ds / track->length + 0.5);
+    last_s = along;
+    st->progress += ds;
+    st->xte_sum += mid * mid;
+    st->xte_samples ++;
+    if(!lost && cover[0] < ROBOT_LOST && cover[1] < ROBOT_LOST)
+    {
+        lost = true;
+        st->line_losses ++;
+    }
+    else if(lost && (cover[0] > ROBOT_FOUND || cover[1] > ROBOT_FOUND))
+    {
+        lost = false;
+    }
+    if(st->progress >= (st->laps + 1) * track->length)
+    {
+        double previous = 0;
+
+        for(int i = 0; i != st->laps && i != ROBOT_MAX_LAPS; i ++)
+        {
+            previous += st->lap_time[i];
+        }
+        if(st->laps < ROBOT_MAX_LAPS)
+        {
+            st->lap_time[st->laps] = t - st->start_time - previous;
+        }
+        st->laps ++;
+        if(st->laps >= robot_laps)
+        {
+            sim_stop();
+        }
+    }
+    off_time = fabs(mid) > ROBOT_OFF_TRACK ? off_time + dt : 0;
+    if(off_time >= ROBOT_DNF_TIME)
+    {
+        st->off_track = true;
+        sim_stop();
+    }
+}
@@ -0,0 +1,152 @@
+/*==============================================================================
+ File: robot.h
+ Date: October 17, 2026
+
+ CHRP4 host simulator robot and track model definitions
+
+ Robot model:
+ robot_world() is a sim_world function (see sim.h) that drives a model of
+ the CHRP4 robot from the firmware's pin outputs. Each motor sees the average
+ level of its two driver inputs over a PWM period, split into forward drive
+ (A high, B low for the left motor), reverse drive, brake (both high) and
+ coast (both low). Drive pulls the wheel speed towards the full speed for the
+ supply voltage, brake pulls it towards zero, with the motor time constant,
+ and coast lets it run down slowly. The wheel speeds move the robot as a
+ differential drive. Q1 and Q2 look at spots just ahead of the axle, and the
+ part of each spot that covers the line sets its reflectance. The
+ phototransistors pull their inputs down in proportion to the light reaching
+ them (reflected D6 light plus ambient light), with a short response time, and
+ the ADC sees their voltages plus noise. The digital inputs switch at half of
+ the supply voltage.
+
+ Tracks:
+ A track is a closed polyline of line centre points, read from a CSV file of
+ x_mm,y_mm rows (see tracks/). Comment lines may set the line width, line
+ reflectance and floor reflectance, for example: # line_width 19
+ A "# marker at_mm length_mm width_mm" line adds a start/finish marker (see
+ Track.h): a bar of line across the track, starting at_mm along the line from
+ the first point, length_mm long and width_mm wide, centred on the line.
+
+ Statistics:
+ While the robot runs, robot_world() measures lap times (from its first
+ movement after robot_start), the RMS cross-track error of the point between
+ the sensors, and the number of times both sensors lose the line. It calls
+ sim_stop() once robot_laps laps are done, or after the robot has been off
+ the track for ROBOT_DNF_TIME.
+
+ Units are metres, seconds, volts and amps unless noted.
+==============================================================================*/
+
+#ifndef ROBOT_H
+#define ROBOT_H
+
+#include    <stdbool.h>
+
+#define ROBOT_MAX_POINTS 4096       // Track polyline points
+#define ROBOT_MAX_LAPS  16          // Lap times kept
+#define ROBOT_QUANTUM   50e-6       // World model update period
+#define ROBOT_OFF_TRACK 0.12        // Distance from the line that is off track
+#define ROBOT_DNF_TIME  2.0         // Time off track that ends a run
+#define ROBOT_LOST      0.05        // Line coverage below which a sensor is lost
+#define ROBOT_FOUND     0.2         // Line coverage that finds the line again
+
+typedef struct
+{
+    char name[64];                  // File name without the directory
+    int points;                     // Number of points
+    double x[ROBOT_MAX_POINTS];     // Line centre points
+    double y[ROBOT_MAX_POINTS];
+    double s[ROBOT_MAX_POINTS + 1]; // Distance along the line to each point
+    double length;                  // Loop length
+    double line_width;              // Line width
+    double line_reflectance;        // Line reflectance (0-1)
+    double floor_reflectance;       // Floor reflectance (0-1)
+    double marker_at;               // Marker start along the line
+    double marker_length;           // Marker length along the line (0 = none)
+    double marker_width;            // Marker width across the line
+} robot_track_t;
+
+typedef struct
+{
+    double wheelbase;               // Distance between the wheels
+    double sensor_ahead;            // Sensors ahead of the axle
+    double sensor_spacing;          // Distance between Q1 and Q2
+    double spot_radius;             // Sensor spot radius
+    double speed_max;               // Full drive wheel speed at 4.5 V
+    double motor_tau;               // Motor speed time constant
+    double coast_tau;               // Coasting run down time constant
+    double right_gain;              // Right wheel speed relative to the left
+    double motor_ohms;              // Motor winding resistance
+    double motor_idle;              // Motor friction current
+    double sensor_gain;             // Fraction of VDD per unit of light
+    double sensor_tau;              // Phototransistor response time
+    double ambient;                 // Ambient light (units of full D6 light)
+    double flicker;                 // 100 Hz ambient modulation depth (0-1)
+    double noise;                   // ADC input noise (V RMS)
+} robot_params_t;
+
+typedef struct
+{
+    bool started;                   // The robot has moved
+    double start_time;              // Time of the first movement
+    int laps;                       // Laps completed
+    double lap_time[ROBOT_MAX_LAPS];    // Lap times
+    double progress;                // Distance along the line since the start
+    double xte_sum;                 // Sum of the squared cross-track errors
+    long xte_samples;               // Cross-track error samples
+    int line_losses;                // Times both sensors lost the line
+    bool off_track;                 // Stopped by ROBOT_DNF_TIME off track
+    double motor_charge;            // Charge drawn by the motors (C)
+} robot_stats_t;
+
+extern robot_params_t robot_params; // Robot model parameters
+extern robot_stats_t robot_stats;   // Statistics of the current run
+extern int robot_laps;              // Laps to run before sim_stop()
+extern double robot_start;          // Earliest time the lap timer starts
+
+/**
+ * Function: bool robot_track_load(const char *path, robot_track_t *track)
+ *
+ * Read a track CSV file. Returns false (after printing why) if it can't.
+ */
+bool robot_track_load(const char *, robot_track_t *);
+
+/**
+ * Function: void robot_place(const robot_track_t *track)
+ *
+ * Put the robot at the first point of a track, facing the second point,
+ * stopped, with the statistics cleared, and make robot_world() the world
+ * model. Call after sim_power_on().
+ */
+void robot_place(const robot_track_t *);
+
+/**
+ * Function: void robot_world(void)
+ *
+ * Advance the robot model by sim_quantum and update the sensor inputs.
+ */
+void robot_world(void);
+
+/**
+ * Function: double robot_sensor_volts(double reflectance, bool led,
+ *                                     double ambient)
+ *
+ * Return the steady phototransistor voltage over a surface.
+ */
+double robot_sensor_volts(double, bool, double);
+
+/**
+ * Function: double robot_ambient(double t)
+ *
+ * Return the ambient light at time t, including flicker.
+ */
+double robot_ambient(double);
+
+/**
+ * Function: double robot_xte_rms(void)
+ *
+ * Return the RMS cross-track error of the current run.
+ */
+double robot_xte_rms(void);
+
+#endif
@@ -0,0 +1,198 @@
+/*==============================================================================
+ File: scanbench.c
+ Date: October 17, 2026
+
+ CHRP4 host simulator ADC sampling benchmark
+
+ Compares the floor sensor sample rate of the blocking ADC_read_channel()
+ path with the background ADC scan engine (see CHRP4.h). For each, the
+ firmware samples for one second of simulated time and the benchmark prints
+ the sensor samples per second delivered to the main program, the ADC
+ conversions per second, and the share of the CPU the sampling takes. The
+ blocking path is measured on its own and inside the Learn More analog loop,
+ and the scan engine in raw mode and in synchronous mode for each number of
+ averaged LED off/on pairs, with the rate of its oversampled 12-bit sets.
+ Build it with SENSOR_ARRAY defined (the scanbench-array program) to scan four
+ or more channels.
+
+ It then checks the effective resolution of the 12-bit sets. The sensor input
+ is stepped by a quarter of a 10-bit LSB at a time, with 1 LSB RMS of noise
+ added to each conversion, and the benchmark prints the mean 8-bit and 12-bit
+ results at each step. Each step should raise the 12-bit mean by about 1.
+
+ Usage: scanbench
+==============================================================================*/
+
+#include    <stdint.h>
+#include    <stdbool.h>
+#include    <stdio.h>
+
+#include    "xc.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/CHRP4.h"
+#include    "../../CHRP4-Starter-1-Simple-Robot.X/Motors.h"
+#include    "learn.h"
+
+#undef int
+
+#define RUN_TIME        1.0         // Sampling time for each case (s)
+#define GREY_VOLTS      2.4         // Sensor input voltage
+#define NOISE_LSB       1.0         // Resolution check input noise (10-bit LSB)
+#define STEPS           5           // Resolution check input steps
+
+static unsigned char pairs;         // Synchronous sensing pairs (0 = raw)
+static uint32_t reads;              // Blocking samples read
+static uint32_t sets;               // Scan sample sets read
+static uint32_t hires_sets;         // Scan 12-bit sample sets read
+static double offset;               // Resolution check input offset (10-bit LSB)
+static double level_sum;            // Sum of Q1 8-bit levels read
+static double hires_sum;            // Sum of Q1 12-bit levels read
+
+static void setup(void)
+{
+    OSC_config();
+    CHRP4_config();
+    ADC_config();
+    motor_config();
+}
+
+static void blocking(void)
+{
+    for(;;)
+    {
+        ADC_read_channel((reads & 1) ? ANQ2 : ANQ1);
+        reads ++;
+    }
+}
+
+static void learn(void)
+{
+    for(;;)
+    {
+        analog_loop();
+        reads += 2;
+    }
+}
+
+// Start the scan engine, then read each new sample set as it arrives.
+static void scan(void)
+{
+    unsigned char samples[ADC_SCAN_COUNT];
+    unsigned char last;
+    unsigned char count;
+
+    ADC_scan_start();
+    if(pairs)
+    {
+        ADC_scan_sync(pairs);
+    }
+    PEIE = 1;
+    GIE = 1;
+    last = ADC_scan_read(samples);
+    for(;;)
+    {
+        count = ADC_scan_read(samples);
+        sets += (unsigned char)(count - last);
+        last = count;
+        NOP();                  // RAM-only code takes no modelled time
+    }
+}
+
+// Start the scan engine, then add up Q1's 8-bit and 12-bit levels in each new
+// 12-bit set as it arrives.
+static void scan_hires(void)
+{
+    unsigned char samples[ADC_SCAN_COUNT];
+    uint16_t levels[ADC_SCAN_COUNT];
+    unsigned char last;
+    unsigned char count;
+
+    ADC_scan_start();
+    PEIE = 1;
+    GIE = 1;
+    last = 0;
+    for(;;)
+    {
+        count = ADC_scan_hires(levels);
+        if(count != last)
+        {
+            ADC_scan_read(samples);
+            hires_sets += (unsigned char)(count - last);
+            last = count;
+            level_sum += samples[SCAN_Q1];
+            hires_sum += levels[SCAN_Q1];
+        }
+        NOP();                  // RAM-only code takes no modelled time
+    }
+}
+
+// Noisy sensor input for the resolution check.
+static void noisy(void)
+{
+    sim_an[6] = GREY_VOLTS + (offset + NOISE_LSB * sim_gauss()) * sim_vdd / 1024;
+}
+
+// Run a sampling entry point for RUN_TIME from power-up, and print its
+// sample rate, conversion rate and CPU use.
+static void bench(const char *name, void (*entry)(void), uint32_t *samples, int per)
+{
+    double start;
+    double elapsed;
+    uint64_t isr_cycles;
+    uint32_t conversions;
+
+    sim_power_on();
+    sim_run(setup, 1);
+    *samples = 0;
+    start = sim_time();
+    isr_cycles = sim_isr_cycles;
+    conversions = sim_adc_conversions;
+    sim_run(entry, RUN_TIME);
+    elapsed = sim_time() - start;
+    printf("%-34s %10.0f %10.0f %8.1f%%\n", name, *samples * per / elapsed,
+           (sim_adc_conversions - conversions) / elapsed,
+           entry != blocking && entry != learn ? 100.0 * (sim_isr_cycles - isr_cycles) * sim_cycle_time() /
+           elapsed : 100.0);
+}
+
+int main(void)
+{
+    char name[40];
+
+    for(int i = 0; i != 32; i ++)
+    {
+        sim_an[i] = GREY_VOLTS;
+    }
+
+    printf("%d scanned channels. Modelled cycles are a lower bound (see sim.h).\n\n",
+           ADC_SCAN_COUNT);
+    printf("%-34s %10s %10s %9s\n", "", "samples/s", "convs/s", "CPU");
+    bench("ADC_read_channel() loop", blocking, &reads, 1);
+    bench("Learn More analog loop", learn, &reads, 1);
+    bench("Scan engine, raw", scan, &sets, ADC_SCAN_COUNT);
+    for(pairs = 1; pairs <= ADC_SYNC_MAX; pairs <<= 1)
+    {
+        snprintf(name, sizeof(name), "Scan engine, %d sync pair%s", pairs,
+                 pairs == 1 ? "" : "s");
+        bench(name, scan, &sets, ADC_SCAN_COUNT);
+    }
+    bench("Scan engine, raw, 12-bit sets", scan_hires, &hires_sets, ADC_SCAN_COUNT);
+    printf("\nThe blocking paths keep the CPU busy for every sample. The scan engine\n"
+           "CPU share is its interrupt time, leaving the rest for the main program.\n");
+
+    printf("\n12-bit resolution, with %.1f LSB RMS input noise:\n", NOISE_LSB);
+    printf("%-12s %8s %8s\n", "Input (LSB)", "8-bit", "12-bit");
+    sim_world = noisy;
+    for(int step = 0; step != STEPS; step ++)
+    {
+        offset = step / 4.0;
+        level_sum = 0;
+        hires_sum = 0;
+        hires_sets = 0;
+        sim_power_on();
+        sim_run(setup, 1);
+        sim_run(scan_hires, RUN_TIME * 4);
+        printf("%+-12.2f %8.2f %8.2f\n", offset, level_sum / hires_sets,
+               hires_sum / hires_sets);
+    }
+    return (0);
+}
@@ -0,0 +1,1221 @@
+/*==============================================================================
+ File: sim.c
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) host simulator functions
+
+ Register access, peripheral and interrupt models for running the firmware on
+ a host (see sim.h). Peripherals are brought up to date lazily: sim_touch()
+ only counts a cycle until the cycle of the next peripheral event (sim_next)
+ is reached, and sim_sync() services the peripherals straight away and again
+ at the next access, when the value it wrote is acted on.
+==============================================================================*/
+
+#include    <stdint.h>
+#include    <stdbool.h>
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+#include    <math.h>
+#include    <setjmp.h>
+#include    <unistd.h>
+#include    <sys/wait.h>
+
+#include    "sim.h"
+
+extern void isr(void);              // Firmware interrupt service routine
+
+// Register bits used by the models
+#define INTCON_GIE      0x80
+#define INTCON_PEIE     0x40
+#define INTCON_TMR0IE   0x20
+#define INTCON_IOCIE    0x08
+#define INTCON_TMR0IF   0x04
+#define INTCON_IOCIF    0x01
+#define PIR1_ADIF       0x40
+#define PIR1_TXIF       0x10
+#define PIR1_TMR2IF     0x02
+#define PIR1_TMR1IF     0x01
+#define PIR2_C2IF       0x40
+#define PIR2_C1IF       0x20
+#define ADCON0_GO       0x02
+#define ADCON0_ADON     0x01
+#define TXSTA_TXEN      0x20
+#define TXSTA_BRGH      0x04
+#define TXSTA_TRMT      0x02
+#define RCSTA_SPEN      0x80
+#define BAUDCON_BRG16   0x08
+#define PMCON1_CFGS     0x40
+#define PMCON1_LWLO     0x20
+#define PMCON1_FREE     0x10
+#define PMCON1_WREN     0x04
+#define PMCON1_WR       0x02
+#define PMCON1_RD       0x01
+#define PWMCON_EN       0x80
+#define PWMCON_OE       0x40
+#define PWMCON_POL      0x10
+
+#define ISR_ENTRY       4           // Interrupt latency (cycles)
+#define ISR_EXIT        2           // RETFIE (cycles)
+#define ADC_TADS        11.5        // Conversion time (TAD periods)
+#define ADC_FRC_TAD     1.6e-6      // ADC RC oscillator TAD (s)
+#define FVR_VOLTS       1.024       // FVR x1 output (V)
+
+volatile uint8_t sim_sfr[SFR_COUNT];
+uint64_t sim_cycles;
+uint64_t sim_next;
+
+void (*sim_world)(void);
+double sim_quantum = 100e-6;
+double sim_vdd = 4.8;
+double sim_an[32];
+double (*sim_adc_input)(uint8_t);
+uint8_t sim_input[3];
+void (*sim_uart_tx)(uint8_t);
+FILE *sim_uart_file;
+
+uint16_t sim_hef[SIM_HEF_ROWS * SIM_HEF_WORDS];
+uint32_t sim_hef_erases[SIM_HEF_ROWS];
+uint32_t sim_hef_writes[SIM_HEF_ROWS];
+
+uint64_t sim_isr_cycles;
+uint32_t sim_isr_count;
+uint32_t sim_uart_bytes;
+uint32_t sim_adc_conversions;
+uint64_t sim_t0_overflow;
+double sim_profile_time[SIM_PROFILES];
+double sim_high_time[3][8];
+double sim_adc_on_time;
+
+static uint8_t shadow[SFR_COUNT];   // Registers as last acted on
+static volatile uint8_t *pending;   // sim_sync() access to act on next
+static uint8_t pending_value;       // Its register value before the access
+
+static uint64_t done_cycle;         // Peripherals are up to date to here
+static uint64_t base_cycle;         // Cycle count at base_time
+static double base_time;            // Time of the last clock change (s)
+static double cycle_time;           // Instruction cycle period (s)
+static int profile;                 // Clock profile (SIM_48MHZ...)
+
+static uint32_t t0_prescale;        // Timer0 prescaler count
+static uint32_t t1_prescale;        // Timer1 prescaler count
+static uint32_t t2_prescale;        // Timer2 prescaler count
+static uint8_t t2_postscale;        // Timer2 postscaler count
+static uint16_t pwm_duty[2];        // Duty cycles latched at the period start
+
+static bool adc_busy;               // Conversion in progress
+static uint64_t adc_done;           // Cycle the conversion completes
+static double adc_volts;            // Sampled input voltage
+
+static bool tsr_busy;               // Transmit shift register in use
+static uint64_t tsr_done;           // Cycle the byte has been shifted out
+static uint8_t tsr_data;            // Byte being shifted out
+static bool txreg_full;             // TXREG holds the next byte
+static uint8_t txreg_data;          // Next byte
+
+static uint8_t flash_unlock;        // PMCON2 unlock sequence progress
+static uint16_t flash_latch[SIM_HEF_WORDS];     // Row write latches
+
+static uint8_t pin_levels[2];       // PORTA and PORTB levels for IOC
+static uint8_t cm_out;              // Comparator outputs (MC1OUT, MC2OUT)
+
+static double world_time;           // Time of the next world model update
+static double stop_time;            // sim_run() time limit
+static bool running;                // In sim_run()
+static bool in_isr;                 // In isr()
+static jmp_buf run_exit;            // sim_run() exit
+
+static uint64_t rng = 0x9E3779B97F4A7C15ULL;    // Random number state
+
+/*==============================================================================
+ Time
+ =============================================================================*/
+
+double sim_time(void)
+{
+    return (base_time + (double)(sim_cycles - base_cycle) * cycle_time);
+}
+
+double sim_cycle_time(void)
+{
+    return (cycle_time);
+}
+
+// Return the first cycle at or after time t.
+static uint64_t cycle_at(double t)
+{
+    double cycles = (t - base_time) / cycle_time;
+
+    if(cycles <= 0)
+    {
+        return (base_cycle);
+    }
+    return (base_cycle + (uint64_t)ceil(cycles - 1e-6));
+}
+
+// Set the instruction cycle period from OSCCON. The USB bootloader's
+// configuration (PLLEN, 3x PLLMULT) gives 48 MHz from the 16 MHz HFINTOSC when
+// SCS selects the configured oscillator.
+static void clock_update(void)
+{
+    static const double ircf_hz[16] =
+    {
+        31e3, 31e3, 31.25e3, 31.25e3, 62.5e3, 125e3, 250e3, 500e3,
+        125e3, 250e3, 500e3, 1e6, 2e6, 4e6, 8e6, 16e6
+    };
+    uint8_t osccon = shadow[SFR_OSCCON];
+    uint8_t ircf = (osccon >> 2) & 0x0F;
+    double fosc = ircf_hz[ircf];
+
+    base_time = sim_time();
+    base_cycle = sim_cycles;
+    profile = SIM_OTHER;
+    if(ircf == 15)
+    {
+        profile = SIM_16MHZ;
+        if((osccon & 0x03) == 0)
+        {
+            fosc = 48e6;
+            profile = SIM_48MHZ;
+        }
+    }
+    else if(ircf == 7)
+    {
+        profile = SIM_500KHZ;
+    }
+    cycle_time = 4 / fosc;
+}
+
+/*==============================================================================
+ Pins
+ =============================================================================*/
+
+// Return the Timer2 position in prescaled counts at the current cycle.
+static uint32_t t2_position(void)
+{
+    static const uint8_t prescale[4] = {1, 4, 16, 64};
+    uint32_t ps = prescale[shadow[SFR_T2CON] & 0x03];
+    uint32_t period = (shadow[SFR_PR2] + 1U) * ps;
+    uint32_t pos = sim_sfr[SFR_TMR2] * ps + t2_prescale;
+
+    if(shadow[SFR_T2CON] & 0x04)
+    {
+        pos += (uint32_t)(sim_cycles - done_cycle);
+    }
+    return (pos % period);
+}
+
+// PWM output level, or the fraction of each period it is high.
+static double pwm_level(uint8_t n, bool average)
+{
+    static const uint8_t prescale[4] = {1, 4, 16, 64};
+    uint8_t con = sim_sfr[n == 0 ? SFR_PWM1CON : SFR_PWM2CON];
+    uint32_t ps = prescale[shadow[SFR_T2CON] & 0x03];
+    uint32_t period = (shadow[SFR_PR2] + 1U) * ps;
+    uint32_t width = pwm_duty[n] * ps / 4;
+    double level;
+
+    if(!(con & PWMCON_EN))
+    {
+        return (0);
+    }
+    if(average)
+    {
+        level = width >= period ? 1.0 : (double)width / period;
+    }
+    else
+    {
+        level = t2_position() < width;
+    }
+    return ((con & PWMCON_POL) ? 1 - level : level);
+}
+
+static bool pwm_pin(uint8_t port, uint8_t bit, uint8_t *n)
+{
+    uint8_t con;
+
+    if(port != 2 || (bit != 5 && bit != 6))
+    {
+        return (false);
+    }
+    *n = bit - 5;
+    con = sim_sfr[*n == 0 ? SFR_PWM1CON : SFR_PWM2CON];
+    return ((con & (PWMCON_EN | PWMCON_OE)) == (PWMCON_EN | PWMCON_OE));
+}
+
+uint8_t sim_pin(uint8_t port, uint8_t bit)
+{
+    uint8_t mask = 1 << bit;
+    uint8_t n;
+
+    if(!(sim_sfr[SFR_TRISA + port] & mask) && !(port == 0 && bit == 3))
+    {
+        if(pwm_pin(port, bit, &n))
+        {
+            return (pwm_level(n, false) != 0);
+        }
+        return ((sim_sfr[SFR_LATA + port] & mask) != 0);
+    }
+    if(sim_sfr[SFR_ANSELA + port] & mask)
+    {
+        return (0);
+    }
+    return ((sim_input[port] & mask) != 0);
+}
+
+double sim_pin_duty(uint8_t port, uint8_t bit)
+{
+    uint8_t n;
+
+    if(!(sim_sfr[SFR_TRISA + port] & (1 << bit)) && pwm_pin(port, bit, &n))
+    {
+        return (pwm_level(n, true));
+    }
+    return (sim_pin(port, bit));
+}
+
+void sim_button(uint8_t sw, bool pressed)
+{
+    uint8_t port = sw == 1 ? 0 : 1;
+    uint8_t mask = sw == 1 ? 0x08 : 0x10 << (sw - 2);
+
+    if(pressed)
+    {
+        sim_input[port] &= (uint8_t)~mask;
+    }
+    else
+    {
+        sim_input[port] |= mask;
+    }
+}
+
+static uint8_t port_levels(uint8_t port)
+{
+    uint8_t levels = 0;
+
+    for(uint8_t bit = 0; bit != 8; bit ++)
+    {
+        levels |= sim_pin(port, bit) << bit;
+    }
+    return (levels);
+}
+
+/*==============================================================================
+ Peripherals
+ =============================================================================*/
+
+// Set or clear hardware status bits in both the register and its shadow, so
+// that they are not mistaken for firmware writes.
+static void hw_set(uint8_t sfr, uint8_t mask)
+{
+    sim_sfr[sfr] |= mask;
+    shadow[sfr] |= mask;
+}
+
+static void hw_clear(uint8_t sfr, uint8_t mask)
+{
+    sim_sfr[sfr] &= (uint8_t)~mask;
+    shadow[sfr] &= (uint8_t)~mask;
+}
+
+static void hw_put(uint8_t sfr, uint8_t mask, bool set)
+{
+    if(set)
+    {
+        hw_set(sfr, mask);
+    }
+    else
+    {
+        hw_clear(sfr, mask);
+    }
+}
+
+static void __attribute__((noreturn)) finish(int reason)
+{
+    if(!running)
+    {
+        fprintf(stderr, "sim: firmware stopped (%d) outside sim_run()\n", reason);
+        exit(1);
+    }
+    longjmp(run_exit, reason);
+}
+
+// Voltage of an ADC channel.
+static double adc_input(uint8_t chs)
+{
+    uint8_t fvrcon = sim_sfr[SFR_FVRCON];
+
+    switch(chs)
+    {
+        case 0x1F:                  // FVR buffer 1
+            if(!(fvrcon & 0x80) || !(fvrcon & 0x03))
+            {
+                return (0);
+            }
+            return (FVR_VOLTS * (1 << ((fvrcon & 0x03) - 1)));
+        case 0x1E:                  // DAC
+            return (sim_vdd * (sim_sfr[SFR_DACCON1] & 0x1F) / 32);
+        case 0x1D:                  // Temperature indicator
+            return (0.6);
+        default:
+            return (sim_adc_input ? sim_adc_input(chs) : sim_an[chs]);
+    }
+}
+
+static void adc_start(uint64_t cycle)
+{
+    static const double tad_cycles[8] = {0.5, 2, 8, 0, 1, 4, 16, 0};
+    double tad = tad_cycles[(shadow[SFR_ADCON1] >> 4) & 0x07];
+
+    if(tad == 0)
+    {
+        tad = ADC_FRC_TAD / cycle_time;
+    }
+    adc_volts = adc_input((sim_sfr[SFR_ADCON0] >> 2) & 0x1F);
+    adc_busy = true;
+    adc_done = cycle + (uint64_t)ceil(ADC_TADS * tad);
+    hw_set(SFR_ADCON0, ADCON0_GO);
+}
+
+static void adc_complete(void)
+{
+    double vref = sim_vdd;
+    double code;
+    uint16_t result;
+
+    if((shadow[SFR_ADCON1] & 0x03) == 0x03)
+    {
+        vref = adc_input(0x1F);     // FVR positive reference
+    }
+    code = floor(adc_volts / vref * 1024);
+    result = code < 0 ? 0 : code > 1023 ? 1023 : (uint16_t)code;
+    if(shadow[SFR_ADCON1] & 0x80)
+    {
+        sim_sfr[SFR_ADRESH] = result >> 8;
+        sim_sfr[SFR_ADRESL] = result & 0xFF;
+    }
+    else
+    {
+        sim_sfr[SFR_ADRESH] = result >> 2;
+        sim_sfr[SFR_ADRESL] = (result & 0x03) << 6;
+    }
+    adc_busy = false;
+    sim_adc_conversions ++;
+    hw_clear(SFR_ADCON0, ADCON0_GO);
+    hw_set(SFR_PIR1, PIR1_ADIF);
+}
+
+// Instruction cycles per bit for the current baud rate generator setting.
+static uint32_t uart_bit_cycles(void)
+{
+    uint32_t brg = shadow[SFR_SPBRGL];
+    bool brg16 = shadow[SFR_BAUDCON] & BAUDCON_BRG16;
+    bool brgh = shadow[SFR_TXSTA] & TXSTA_BRGH;
+
+    if(brg16)
+    {
+        brg |= shadow[SFR_SPBRGH] << 8;
+    }
+    return ((brg + 1) * (brg16 && brgh ? 1 : brg16 || brgh ? 4 : 16));
+}
+
+static void uart_load(uint8_t data, uint64_t cycle)
+{
+    tsr_busy = true;
+    tsr_data = data;
+    tsr_done = cycle + 1 + 10 * uart_bit_cycles();
+}
+
+static void uart_write(uint8_t data)
+{
+    if(!(sim_sfr[SFR_RCSTA] & RCSTA_SPEN) || !(sim_sfr[SFR_TXSTA] & TXSTA_TXEN))
+    {
+        return;
+    }
+    if(!tsr_busy)
+    {
+        uart_load(data, sim_cycles);
+    }
+    else
+    {
+        txreg_full = true;
+        txreg_data = data;
+    }
+}
+
+static void uart_shifted(uint64_t cycle)
+{
+    sim_uart_bytes ++;
+    if(sim_uart_tx)
+    {
+        sim_uart_tx(tsr_data);
+    }
+    if(sim_uart_file)
+    {
+        fputc(tsr_data, sim_uart_file);
+    }
+    tsr_busy = false;
+    if(txreg_full)
+    {
+        txreg_full = false;
+        uart_load(txreg_data, cycle);
+    }
+}
+
+// Comparator outputs from the DAC (or FVR) and the C12INx- pin voltages.
+static void comparators(void)
+{
+    uint8_t out = 0;
+    uint8_t rising;
+    uint8_t falling;
+
+    for(uint8_t n = 0; n != 2; n ++)
+    {
+        uint8_t con0 = sim_sfr[n == 0 ? SFR_CM1CON0 : SFR_CM2CON0];
+        uint8_t con1 = sim_sfr[n == 0 ? SFR_CM1CON1 : SFR_CM2CON1];
+        uint8_t nch = con1 & 0x07;
+        double vp = 0;
+        double vn;
+        bool high;
+
+        if(!(con0 & 0x80))
+        {
+            continue;
+        }
+        if(((con1 >> 4) & 0x03) == 1 && (sim_sfr[SFR_DACCON0] & 0x80))
+        {
+            vp = sim_vdd * (sim_sfr[SFR_DACCON1] & 0x1F) / 32;
+        }
+        else if(((con1 >> 4) & 0x03) == 2)
+        {
+            vp = FVR_VOLTS;
+        }
+        vn = nch < 4 ? sim_an[4 + nch] : FVR_VOLTS;
+        if(con0 & 0x02)             // Hysteresis
+        {
+            vn += (cm_out & (1 << n)) != !!(con0 & 0x10) ? -0.01 : 0.01;
+        }
+        high = (vp > vn) != !!(con0 & 0x10);
+        out |= high << n;
+    }
+
+    rising = out & ~cm_out;
+    falling = cm_out & ~out;
+    for(uint8_t n = 0; n != 2; n ++)
+    {
+        uint8_t con0 = n == 0 ? SFR_CM1CON0 : SFR_CM2CON0;
+        uint8_t con1 = sim_sfr[n == 0 ? SFR_CM1CON1 : SFR_CM2CON1];
+
+        hw_put(con0, 0x40, out & (1 << n));
+        if(((rising & (1 << n)) && (con1 & 0x80)) ||
+           ((falling & (1 << n)) && (con1 & 0x40)))
+        {
+            hw_set(SFR_PIR2, n == 0 ? PIR2_C1IF : PIR2_C2IF);
+        }
+    }
+    cm_out = out;
+    sim_sfr[SFR_CMOUT] = out;
+}
+
+// Look for interrupt-on-change edges and comparator changes after the inputs
+// may have changed.
+static void inputs_changed(void)
+{
+    static const uint8_t flags[2] = {SFR_IOCAF, SFR_IOCBF};
+    static const uint8_t pos[2] = {SFR_IOCAP, SFR_IOCBP};
+    static const uint8_t neg[2] = {SFR_IOCAN, SFR_IOCBN};
+
+    for(uint8_t port = 0; port != 2; port ++)
+    {
+        uint8_t levels = port_levels(port);
+        uint8_t edges = (levels & ~pin_levels[port] & sim_sfr[pos[port]]) |
+                        (~levels & pin_levels[port] & sim_sfr[neg[port]]);
+
+        if(edges)
+        {
+            hw_set(flags[port], edges);
+        }
+        pin_levels[port] = levels;
+    }
+    comparators();
+    hw_put(SFR_INTCON, INTCON_IOCIF, sim_sfr[SFR_IOCAF] | sim_sfr[SFR_IOCBF]);
+}
+
+// Keep the read-only status bits up to date.
+static void status(void)
+{
+    hw_put(SFR_PIR1, PIR1_TXIF, (sim_sfr[SFR_TXSTA] & TXSTA_TXEN) && !txreg_full);
+    hw_put(SFR_TXSTA, TXSTA_TRMT, !tsr_busy);
+    hw_put(SFR_INTCON, INTCON_IOCIF, sim_sfr[SFR_IOCAF] | sim_sfr[SFR_IOCBF]);
+    hw_put(SFR_FVRCON, 0x40, sim_sfr[SFR_FVRCON] & 0x80);
+    hw_set(SFR_PMCON1, 0x80);
+    sim_sfr[SFR_OSCSTAT] = 0x7F;    // Every oscillator is ready
+}
+
+/*==============================================================================
+ Timers and events
+ =============================================================================*/
+
+static uint32_t t0_prescaler(void)
+{
+    uint8_t option = shadow[SFR_OPTION_REG];
+
+    return ((option & 0x08) ? 1 : 2U << (option & 0x07));
+}
+
+// Return the cycle of the next timer, ADC, EUSART or world model event.
+static uint64_t next_event(void)
+{
+    static const uint8_t prescale[4] = {1, 4, 16, 64};
+    uint64_t event = UINT64_MAX;
+    uint64_t cycle;
+
+    if(!(shadow[SFR_OPTION_REG] & 0x20))
+    {
+        cycle = done_cycle + (256U - sim_sfr[SFR_TMR0]) * t0_prescaler() - t0_prescale;
+        event = cycle < event ? cycle : event;
+    }
+    if(shadow[SFR_T2CON] & 0x04)
+    {
+        uint32_t ps = prescale[shadow[SFR_T2CON] & 0x03];
+        uint32_t period = (shadow[SFR_PR2] + 1U) * ps;
+        uint32_t pos = sim_sfr[SFR_TMR2] * ps + t2_prescale;
+
+        cycle = done_cycle + (pos < period ? period - pos : 256 * ps - pos);
+        event = cycle < event ? cycle : event;
+    }
+    if(adc_busy && adc_done < event)
+    {
+        event = adc_done;
+    }
+    if(tsr_busy && tsr_done < event)
+    {
+        event = tsr_done;
+    }
+    if(sim_world)
+    {
+        cycle = cycle_at(world_time);
+        event = cycle < event ? cycle : event;
+    }
+    return (event);
+}
+
+// Time spent in each clock profile, with the ADC on, and with each pin high.
+static void account(double seconds, int state)
+{
+    sim_profile_time[state] += seconds;
+    if(sim_sfr[SFR_ADCON0] & ADCON0_ADON)
+    {
+        sim_adc_on_time += seconds;
+    }
+    for(uint8_t port = 0; port != 3; port ++)
+    {
+        uint8_t outputs = ~sim_sfr[SFR_TRISA + port];
+
+        for(uint8_t bit = 0; outputs; bit ++, outputs >>= 1)
+        {
+            if(outputs & 1)
+            {
+                sim_high_time[port][bit] += seconds * sim_pin_duty(port, bit);
+            }
+        }
+    }
+}
+
+static void timer2_match(uint64_t cycle)
+{
+    if(t2_postscale ++ >= ((shadow[SFR_T2CON] >> 3) & 0x0F))
+    {
+        t2_postscale = 0;
+        hw_set(SFR_PIR1, PIR1_TMR2IF);
+    }
+    pwm_duty[0] = (sim_sfr[SFR_PWM1DCH] << 2) | (sim_sfr[SFR_PWM1DCL] >> 6);
+    pwm_duty[1] = (sim_sfr[SFR_PWM2DCH] << 2) | (sim_sfr[SFR_PWM2DCL] >> 6);
+    if((shadow[SFR_ADCON2] >> 4) == 0x05 && (sim_sfr[SFR_ADCON0] & ADCON0_ADON) &&
+       !adc_busy)
+    {
+        adc_start(cycle);           // Auto-conversion trigger
+    }
+}
+
+// Advance the peripherals to a cycle no later than the next event.
+static void step_to(uint64_t cycle)
+{
+    static const uint8_t prescale[4] = {1, 4, 16, 64};
+    uint64_t cycles = cycle - done_cycle;
+
+    account(cycles * cycle_time, profile);
+
+    if(!(shadow[SFR_OPTION_REG] & 0x20))
+    {
+        uint32_t ps = t0_prescaler();
+        uint64_t total = t0_prescale + cycles;
+        uint64_t count = sim_sfr[SFR_TMR0] + total / ps;
+
+        t0_prescale = total % ps;
+        if(count > 0xFF)
+        {
+            hw_set(SFR_INTCON, INTCON_TMR0IF);
+            sim_t0_overflow = cycle;
+        }
+        sim_sfr[SFR_TMR0] = (uint8_t)count;
+    }
+
+    if((shadow[SFR_T1CON] & 0x01) && (shadow[SFR_T1CON] & 0x80) == 0)
+    {
+        uint32_t ps = 1U << ((shadow[SFR_T1CON] >> 4) & 0x03);
+        uint64_t total = t1_prescale + cycles * ((shadow[SFR_T1CON] & 0x40) ? 4 : 1);
+        uint64_t count = ((sim_sfr[SFR_TMR1H] << 8) | sim_sfr[SFR_TMR1L]) + total / ps;
+
+        t1_prescale = total % ps;
+        if(count > 0xFFFF)
+        {
+            hw_set(SFR_PIR1, PIR1_TMR1IF);
+        }
+        sim_sfr[SFR_TMR1H] = (uint8_t)(count >> 8);
+        sim_sfr[SFR_TMR1L] = (uint8_t)count;
+    }
+
+    if(shadow[SFR_T2CON] & 0x04)
+    {
+        uint32_t ps = prescale[shadow[SFR_T2CON] & 0x03];
+        uint32_t period = (shadow[SFR_PR2] + 1U) * ps;
+        uint64_t pos = sim_sfr[SFR_TMR2] * ps + t2_prescale;
+        bool counting = pos < period;
+
+        pos += cycles;
+        if(counting && pos >= period)
+        {
+            pos -= period;
+            timer2_match(cycle);
+        }
+        else if(pos >= 256 * ps)
+        {
+            pos -= 256 * ps;
+        }
+        sim_sfr[SFR_TMR2] = (uint8_t)(pos / ps);
+        t2_prescale = pos % ps;
+    }
+
+    done_cycle = cycle;
+    if(adc_busy && cycle >= adc_done)
+    {
+        adc_complete();
+    }
+    if(tsr_busy && cycle >= tsr_done)
+    {
+        uart_shifted(cycle);
+    }
+    while(sim_world && cycle >= cycle_at(world_time))
+    {
+        sim_world();
+        world_time += sim_quantum;
+        inputs_changed();
+    }
+}
+
+// Bring the peripherals up to date with the cycle count.
+static void advance(void)
+{
+    while(done_cycle < sim_cycles)
+    {
+        uint64_t event = next_event();
+
+        event = event < done_cycle ? done_cycle : event;
+        step_to(event < sim_cycles ? event : sim_cycles);
+    }
+}
+
+static void schedule(void)
+{
+    uint64_t event = next_event();
+
+    if(running)
+    {
+        uint64_t stop = cycle_at(stop_time);
+
+        event = stop < event ? stop : event;
+    }
+    sim_next = event;
+}
+
+/*==============================================================================
+ High-Endurance Flash
+ =============================================================================*/
+
+// Apply a fraction of an erase (bits going to 1) or of a row write (bits
+// going to 0), as left by a power failure part way through.
+static void flash_partial(uint16_t *row, bool erase, double fraction)
+{
+    for(uint8_t w = 0; w != SIM_HEF_WORDS; w ++)
+    {
+        for(uint8_t b = 0; b != 14; b ++)
+        {
+            uint16_t mask = 1 << b;
+
+            if(sim_uniform() >= fraction)
+            {
+                continue;
+            }
+            if(erase)
+            {
+                row[w] |= mask;
+            }
+            else if(!(flash_latch[w] & mask))
+            {
+                row[w] &= (uint16_t)~mask;
+            }
+        }
+    }
+}
+
+// Stall the processor for a row erase or write. Peripherals keep running, and
+// a time limit that passes during the stall is a power failure.
+static void flash_stall(uint16_t *row, bool erase)
+{
+    double start = sim_time();
+    double end = start + SIM_FLASH_MS / 1000;
+
+    if(running && end > stop_time)
+    {
+        if(row != NULL)
+        {
+            flash_partial(row, erase, (stop_time - start) / (end - start));
+        }
+        sim_cycles = cycle_at(stop_time);
+        advance();
+        finish(SIM_TIMEOUT);
+    }
+    if(row != NULL)
+    {
+        for(uint8_t w = 0; w != SIM_HEF_WORDS; w ++)
+        {
+            row[w] = erase ? 0x3FFF : row[w] & flash_latch[w];
+        }
+    }
+    sim_cycles = cycle_at(end);
+    advance();
+}
+
+// Act on RD or an unlocked WR.
+static void flash_access(void)
+{
+    uint8_t pmcon1 = sim_sfr[SFR_PMCON1];
+    uint16_t address = ((sim_sfr[SFR_PMADRH] & 0x7F) << 8) | sim_sfr[SFR_PMADRL];
+    uint16_t data = ((sim_sfr[SFR_PMDATH] & 0x3F) << 8) | sim_sfr[SFR_PMDATL];
+    bool hef = !(pmcon1 & PMCON1_CFGS) && address >= SIM_HEF_START;
+    uint16_t *row = hef ? &sim_hef[(address - SIM_HEF_START) & ~(SIM_HEF_WORDS - 1)] : NULL;
+    uint8_t r = hef ? (address - SIM_HEF_START) / SIM_HEF_WORDS : 0;
+
+    if((pmcon1 & PMCON1_RD) && !(shadow[SFR_PMCON1] & PMCON1_RD))
+    {
+        data = hef ? sim_hef[address - SIM_HEF_START] : 0x3FFF;
+        sim_sfr[SFR_PMDATL] = data & 0xFF;
+        sim_sfr[SFR_PMDATH] = data >> 8;
+        hw_clear(SFR_PMCON1, PMCON1_RD);
+    }
+    if(!(pmcon1 & PMCON1_WR) || (shadow[SFR_PMCON1] & PMCON1_WR))
+    {
+        return;
+    }
+    hw_clear(SFR_PMCON1, PMCON1_WR);
+    if(flash_unlock != 2 || !(pmcon1 & PMCON1_WREN))
+    {
+        flash_unlock = 0;
+        return;
+    }
+    flash_unlock = 0;
+    if(pmcon1 & PMCON1_FREE)
+    {
+        if(hef)
+        {
+            sim_hef_erases[r] ++;
+        }
+        flash_stall(row, true);
+        return;
+    }
+    flash_latch[address & (SIM_HEF_WORDS - 1)] = data;
+    if(!(pmcon1 & PMCON1_LWLO))
+    {
+        if(hef)
+        {
+            sim_hef_writes[r] ++;
+        }
+        flash_stall(row, false);
+        for(uint8_t w = 0; w != SIM_HEF_WORDS; w ++)
+        {
+            flash_latch[w] = 0x3FFF;
+        }
+    }
+}
+
+void sim_hef_erase_all(void)
+{
+    for(uint16_t w = 0; w != SIM_HEF_ROWS * SIM_HEF_WORDS; w ++)
+    {
+        sim_hef[w] = 0x3FFF;
+    }
+    memset(sim_hef_erases, 0, sizeof(sim_hef_erases));
+    memset(sim_hef_writes, 0, sizeof(sim_hef_writes));
+}
+
+/*==============================================================================
+ Register access and interrupts
+ =============================================================================*/
+
+// Act on the last sim_sync() access and on any changed control registers.
+static void act(void)
+{
+    volatile uint8_t *sfr = pending;
+    uint8_t adcon0 = sim_sfr[SFR_ADCON0];
+
+    pending = NULL;
+    if(sfr == &sim_sfr[SFR_PMCON2])
+    {
+        flash_unlock = (flash_unlock == 0 && *sfr == 0x55) ? 1 :
+                       (flash_unlock == 1 && *sfr == 0xAA) ? 2 : 0;
+    }
+    else if(sfr == &sim_sfr[SFR_PMCON1])
+    {
+        flash_access();
+    }
+    else if(sfr != NULL)
+    {
+        flash_unlock = 0;
+    }
+    if(sfr == &sim_sfr[SFR_TXREG])
+    {
+        uart_write(*sfr);
+    }
+    if(!(adcon0 & ADCON0_ADON) || (!(adcon0 & ADCON0_GO) && adc_busy))
+    {
+        adc_busy = false;           // Conversion aborted
+    }
+    else if((adcon0 & ADCON0_GO) && !(shadow[SFR_ADCON0] & ADCON0_GO) && !adc_busy)
+    {
+        adc_start(sim_cycles);
+    }
+
+    if(sim_sfr[SFR_CM1CON0] != shadow[SFR_CM1CON0] ||
+       sim_sfr[SFR_CM1CON1] != shadow[SFR_CM1CON1] ||
+       sim_sfr[SFR_CM2CON0] != shadow[SFR_CM2CON0] ||
+       sim_sfr[SFR_CM2CON1] != shadow[SFR_CM2CON1] ||
+       sim_sfr[SFR_DACCON0] != shadow[SFR_DACCON0] ||
+       sim_sfr[SFR_DACCON1] != shadow[SFR_DACCON1])
+    {
+        comparators();
+    }
+    if(sim_sfr[SFR_OSCCON] != shadow[SFR_OSCCON])
+    {
+        shadow[SFR_OSCCON] = sim_sfr[SFR_OSCCON];
+        clock_update();
+    }
+    memcpy(shadow, (const uint8_t *)sim_sfr, SFR_COUNT);
+    status();
+}
+
+static bool interrupt_pending(void)
+{
+    uint8_t intcon = sim_sfr[SFR_INTCON];
+
+    if(((intcon & INTCON_TMR0IE) && (intcon & INTCON_TMR0IF)) ||
+       ((intcon & INTCON_IOCIE) && (intcon & INTCON_IOCIF)))
+    {
+        return (true);
+    }
+    return ((intcon & INTCON_PEIE) &&
+            ((sim_sfr[SFR_PIE1] & sim_sfr[SFR_PIR1]) ||
+             (sim_sfr[SFR_PIE2] & sim_sfr[SFR_PIR2])));
+}
+
+void sim_service(void)
+{
+    // Writing TMR0 clears the prescaler. Reads also go through sim_sync(), so
+    // only a write that changes the count is taken as one.
+    if(pending == &sim_sfr[SFR_TMR0] && *pending != pending_value)
+    {
+        t0_prescale = 0;
+    }
+    advance();
+    act();
+    if(running && sim_cycles >= cycle_at(stop_time))
+    {
+        finish(SIM_TIMEOUT);
+    }
+    while(!in_isr && (sim_sfr[SFR_INTCON] & INTCON_GIE) && interrupt_pending())
+    {
+        uint64_t start = sim_cycles;
+
+        in_isr = true;
+        hw_clear(SFR_INTCON, INTCON_GIE);
+        sim_cycles += ISR_ENTRY;
+        advance();
+        isr();
+        sim_cycles += ISR_EXIT;
+        hw_set(SFR_INTCON, INTCON_GIE);
+        in_isr = false;
+        sim_isr_cycles += sim_cycles - start;
+        sim_isr_count ++;
+        advance();
+        act();
+    }
+    schedule();
+}
+
+volatile uint8_t *sim_sync(volatile uint8_t *sfr)
+{
+    sim_cycles ++;
+    sim_service();
+    pending = sfr;
+    pending_value = *sfr;
+    sim_next = sim_cycles;          // Act on this access at the next one
+    return (sfr);
+}
+
+volatile uint8_t *sim_port(uint8_t port)
+{
+    if(++ sim_cycles >= sim_next)
+    {
+        sim_service();
+    }
+    sim_sfr[SFR_PORTA + port] = port_levels(port);
+    return (&sim_sfr[SFR_PORTA + port]);
+}
+
+void sim_nop(void)
+{
+    if(++ sim_cycles >= sim_next)
+    {
+        sim_service();
+    }
+}
+
+void sim_delay(uint32_t cycles)
+{
+    while(cycles != 0)
+    {
+        uint64_t room = sim_next > sim_cycles ? sim_next - sim_cycles : 1;
+        uint32_t step = cycles < room ? cycles : (uint32_t)room;
+
+        sim_cycles += step;
+        cycles -= step;
+        if(sim_cycles >= sim_next)
+        {
+            sim_service();
+        }
+    }
+}
+
+// Enabled interrupts wake the processor whether or not GIE is set.
+static bool wake_pending(void)
+{
+    return (interrupt_pending());
+}
+
+// Stop the instruction clock (and the timers) until an enabled interrupt flag
+// is set. The world model keeps running.
+void sim_sleep(void)
+{
+    sim_nop();
+    if(wake_pending())
+    {
+        return;
+    }
+    if(!running && sim_world == NULL)
+    {
+        return;                     // Would never wake
+    }
+    advance();
+    base_time = sim_time();
+    base_cycle = sim_cycles;
+    while(!wake_pending())
+    {
+        double next = sim_world ? world_time : stop_time;
+
+        if(running && next > stop_time)
+        {
+            next = stop_time;
+        }
+        if(next > base_time)
+        {
+            account(next - base_time, SIM_SLEEP);
+            base_time = next;
+        }
+        if(running && base_time >= stop_time)
+        {
+            finish(SIM_TIMEOUT);
+        }
+        if(sim_world && base_time >= world_time)
+        {
+            sim_world();
+            world_time += sim_quantum;
+            inputs_changed();
+        }
+    }
+    sim_next = sim_cycles;          // Take the interrupt at the next access
+}
+
+void sim_reset(void)
+{
+    finish(SIM_RESET);
+}
+
+/*==============================================================================
+ Runs
+ =============================================================================*/
+
+void sim_power_on(void)
+{
+    memset((uint8_t *)sim_sfr, 0, SFR_COUNT);
+    sim_sfr[SFR_TRISA] = 0x3F;
+    sim_sfr[SFR_TRISB] = 0xF0;
+    sim_sfr[SFR_TRISC] = 0xFF;
+    sim_sfr[SFR_ANSELA] = 0x10;
+    sim_sfr[SFR_ANSELB] = 0x30;
+    sim_sfr[SFR_ANSELC] = 0xCF;
+    sim_sfr[SFR_WPUA] = 0x38;
+    sim_sfr[SFR_WPUB] = 0xF0;
+    sim_sfr[SFR_OPTION_REG] = 0xFF;
+    sim_sfr[SFR_OSCCON] = 0xFC;     // 48 MHz, as left by the bootloader
+    sim_sfr[SFR_PCON] = 0x1C;       // Power-on and brown-out resets
+    sim_sfr[SFR_WDTCON] = 0x16;
+    sim_sfr[SFR_PR2] = 0xFF;
+    sim_sfr[SFR_PMCON1] = 0x80;
+    sim_sfr[SFR_TXSTA] = TXSTA_TRMT;
+    memcpy(shadow, (const uint8_t *)sim_sfr, SFR_COUNT);
+    pending = NULL;
+
+    sim_cycles = 0;
+    base_cycle = 0;
+    base_time = 0;
+    done_cycle = 0;
+    clock_update();
+    t0_prescale = 0;
+    t1_prescale = 0;
+    t2_prescale = 0;
+    t2_postscale = 0;
+    pwm_duty[0] = 0;
+    pwm_duty[1] = 0;
+    adc_busy = false;
+    tsr_busy = false;
+    txreg_full = false;
+    flash_unlock = 0;
+    for(uint8_t w = 0; w != SIM_HEF_WORDS; w ++)
+    {
+        flash_latch[w] = 0x3FFF;
+    }
+    cm_out = 0;
+    in_isr = false;
+
+    sim_input[0] = 0x08;            // Pushbuttons released
+    sim_input[1] = 0xF0;
+    sim_input[2] = 0x00;
+    pin_levels[0] = port_levels(0);
+    pin_levels[1] = port_levels(1);
+    world_time = 0;
+
+    sim_isr_cycles = 0;
+    sim_isr_count = 0;
+    sim_uart_bytes = 0;
+    sim_adc_conversions = 0;
+    sim_t0_overflow = 0;
+    memset(sim_profile_time, 0, sizeof(sim_profile_time));
+    memset(sim_high_time, 0, sizeof(sim_high_time));
+    sim_adc_on_time = 0;
+    status();
+    sim_next = 0;
+}
+
+int sim_run(void (*entry)(void), double seconds)
+{
+    volatile int reason;
+
+    stop_time = sim_time() + seconds;
+    running = true;
+    reason = setjmp(run_exit);
+    if(reason == 0)
+    {
+        sim_next = sim_cycles;      // Check the peripherals at the first access
+        entry();
+        reason = SIM_RETURNED;
+    }
+    running = false;
+    in_isr = false;
+    schedule();
+    return (reason);
+}
+
+void sim_stop(void)
+{
+    finish(SIM_STOPPED);
+}
+
+bool sim_isolate(void (*body)(void *), void *data, size_t size)
+{
+    int fds[2];
+    pid_t pid;
+    size_t got = 0;
+    ssize_t n;
+    int status;
+
+    fflush(NULL);
+    if(pipe(fds) != 0 || (pid = fork()) < 0)
+    {
+        perror("sim_isolate");
+        return (false);
+    }
+    if(pid == 0)
+    {
+        close(fds[0]);
+        body(data);
+        if(write(fds[1], data, size) != (ssize_t)size)
+        {
+            _exit(1);
+        }
+        fflush(NULL);
+        _exit(0);
+    }
+    close(fds[1]);
+    while(got < size && (n = read(fds[0], (uint8_t *)data + got, size - got)) > 0)
+    {
+        got += (size_t)n;
+    }
+    close(fds[0]);
+    waitpid(pid, &status, 0);
+    return (got == size && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+/*==============================================================================
+ Random numbers
+ =============================================================================*/
+
+void sim_seed(uint32_t seed)
+{
+    rng = 0x9E3779B97F4A7C15ULL ^ ((uint64_t)seed << 17) ^ seed;
+    if(rng == 0)
+    {
+        rng = 1;
+    }
+}
+
+// xorshift64*
+uint32_t sim_random(void)
+{
+    rng ^= rng >> 12;
+    rng ^= rng << 25;
+    rng ^= rng >> 27;
+    return ((uint32_t)((rng * 0x2545F4914F6CDD1DULL) >> 32));
+}
+
+double sim_uniform(void)
+{
+    return (sim_random() / 4294967296.0);
+}
+
+// Box-Muller transform
+double sim_gauss(void)
+{
+    double u = (sim_random() + 1.0) / 4294967297.0;
+
+    return (sqrt(-2 * log(u)) * cos(2 * M_PI * sim_uniform()));
+}
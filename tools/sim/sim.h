@@ -0,0 +1,245 @@
+/*==============================================================================
+ File: sim.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) host simulator definitions
+
+ The host simulator runs the unmodified robot firmware on a Linux PC. The
+ Makefile builds every firmware module with gcc against the xc.h header in
+ this directory instead of Microchip's, which turns each special function
+ register (SFR) into a host variable reached through sim_touch(), sim_sync()
+ or sim_port(). Those calls count instruction cycles, run the simulated
+ peripherals and dispatch the firmware's isr() when its interrupt is due, so
+ the firmware sees registers, timers and interrupts that behave like the real
+ microcontroller's.
+
+ Timing model:
+ Time advances one instruction cycle per SFR access, plus the cycles of every
+ __delay_us()/__delay_ms() and NOP(), plus the flash self-write stalls, at the
+ instruction cycle rate chosen by OSCCON (12 MHz at 48 MHz). Instructions that
+ only use RAM are free, so cycle counts are a lower bound on what XC8 code
+ takes on the PIC. Use them to compare versions of the code and to check
+ timing-driven behaviour, and the PROFILE build (see Profiler.h) for absolute
+ numbers on the target.
+
+ Peripherals:
+ Timer0 (with its prescaler), Timer1 (instruction clock), Timer2 and the two
+ PWM outputs, the ADC (including its Timer2 auto-trigger and the FVR
+ channel), the EUSART transmitter, interrupt-on-change, the comparators and
+ DAC, the High-Endurance Flash (HEF) rows and the oscillator profiles are
+ modelled. Sleep stops the instruction clock until an enabled interrupt flag
+ is set. Pins that are outputs read back their latch (or PWM) level, digital
+ inputs read sim_input[] and analog inputs read 0. The ADC converts the
+ voltages in sim_an[].
+
+ World models:
+ A host program sets sim_world to a function that is called every sim_quantum
+ seconds of simulated time. It reads the firmware's outputs with sim_pin() and
+ sim_pin_duty(), and sets inputs in sim_input[] and sim_an[]. sim_run() runs
+ a firmware entry point (such as the renamed main(), robot_main()) until it
+ returns, calls RESET(), the world calls sim_stop(), or a time limit passes.
+
+ Integer sizes:
+ xc.h defines int as short while the firmware is compiled so that int and
+ unsigned int are 16 bits wide, as in XC8. Host programs that include
+ firmware headers include xc.h first and #undef int after the last firmware
+ header. long is wider than XC8's 32 bits, which only matters for code that
+ relies on 32-bit overflow.
+==============================================================================*/
+
+#ifndef SIM_H
+#define SIM_H
+
+#include    <stdint.h>
+#include    <stdbool.h>
+#include    <stdio.h>
+
+// Special function register file, in no particular order
+enum
+{
+    SFR_PORTA, SFR_PORTB, SFR_PORTC,
+    SFR_LATA, SFR_LATB, SFR_LATC,
+    SFR_TRISA, SFR_TRISB, SFR_TRISC,
+    SFR_ANSELA, SFR_ANSELB, SFR_ANSELC,
+    SFR_WPUA, SFR_WPUB,
+    SFR_OPTION_REG, SFR_INTCON, SFR_PIE1, SFR_PIE2, SFR_PIR1, SFR_PIR2,
+    SFR_OSCCON, SFR_OSCSTAT, SFR_ACTCON, SFR_PCON, SFR_WDTCON,
+    SFR_TMR0, SFR_TMR1L, SFR_TMR1H, SFR_T1CON, SFR_T1GCON,
+    SFR_TMR2, SFR_PR2, SFR_T2CON,
+    SFR_ADCON0, SFR_ADCON1, SFR_ADCON2, SFR_ADRESL, SFR_ADRESH,
+    SFR_FVRCON, SFR_DACCON0, SFR_DACCON1,
+    SFR_CM1CON0, SFR_CM1CON1, SFR_CM2CON0, SFR_CM2CON1, SFR_CMOUT,
+    SFR_PWM1DCL, SFR_PWM1DCH, SFR_PWM1CON,
+    SFR_PWM2DCL, SFR_PWM2DCH, SFR_PWM2CON,
+    SFR_IOCAP, SFR_IOCAN, SFR_IOCAF, SFR_IOCBP, SFR_IOCBN, SFR_IOCBF,
+    SFR_TXREG, SFR_RCREG, SFR_SPBRGL, SFR_SPBRGH,
+    SFR_RCSTA, SFR_TXSTA, SFR_BAUDCON,
+    SFR_PMADRL, SFR_PMADRH, SFR_PMDATL, SFR_PMDATH, SFR_PMCON1, SFR_PMCON2,
+    SFR_COUNT
+};
+
+// sim_run() results
+#define SIM_RETURNED    0           // The entry point returned
+#define SIM_TIMEOUT     1           // The time limit passed
+#define SIM_RESET       2           // The firmware called RESET()
+#define SIM_STOPPED     3           // The world model called sim_stop()
+
+// Clock profiles, for the time statistics
+#define SIM_48MHZ       0           // 48 MHz (PLL)
+#define SIM_16MHZ       1           // 16 MHz HFINTOSC
+#define SIM_500KHZ      2           // 500 kHz MFINTOSC
+#define SIM_OTHER       3           // Any other oscillator setting
+#define SIM_SLEEP       4           // Sleeping
+#define SIM_PROFILES    5
+
+// HEF (the last four program memory rows)
+#define SIM_HEF_START   0x1F80      // First HEF word address
+#define SIM_HEF_ROWS    4           // HEF rows
+#define SIM_HEF_WORDS   32          // Words per row
+#define SIM_FLASH_MS    2.0         // Row erase and row write times (ms)
+
+// Register file, cycle count and the cycle of the next peripheral event
+extern volatile uint8_t sim_sfr[SFR_COUNT];
+extern uint64_t sim_cycles;
+extern uint64_t sim_next;
+
+// World model interface
+extern void (*sim_world)(void);     // Called every sim_quantum seconds
+extern double sim_quantum;          // World model update period (s)
+extern double sim_vdd;              // Supply voltage (V)
+extern double sim_an[32];           // ADC input voltages by channel (CHS)
+extern double (*sim_adc_input)(uint8_t chs);   // Per-conversion ADC input
+extern uint8_t sim_input[3];        // Digital input levels of PORTA-PORTC
+extern void (*sim_uart_tx)(uint8_t data);      // Called for each sent byte
+extern FILE *sim_uart_file;         // Sent bytes are also written here
+
+// HEF contents and wear
+extern uint16_t sim_hef[SIM_HEF_ROWS * SIM_HEF_WORDS];
+extern uint32_t sim_hef_erases[SIM_HEF_ROWS];
+extern uint32_t sim_hef_writes[SIM_HEF_ROWS];
+
+// Statistics, cleared by sim_power_on()
+extern uint64_t sim_isr_cycles;     // Cycles spent in isr() (with entry/exit)
+extern uint32_t sim_isr_count;      // isr() calls
+extern uint32_t sim_uart_bytes;     // Bytes sent by the EUSART
+extern uint32_t sim_adc_conversions;    // Completed ADC conversions
+extern uint64_t sim_t0_overflow;    // Cycle of the last Timer0 overflow
+extern double sim_profile_time[SIM_PROFILES];  // Time in each clock profile (s)
+extern double sim_high_time[3][8];  // Time each output pin was high (s)
+extern double sim_adc_on_time;      // Time the ADC was on (s)
+
+// Register access, called by the xc.h register macros.
+void sim_service(void);
+
+static inline volatile uint8_t *sim_touch(volatile uint8_t *sfr)
+{
+    if(++ sim_cycles >= sim_next)
+    {
+        sim_service();
+    }
+    return (sfr);
+}
+
+volatile uint8_t *sim_sync(volatile uint8_t *sfr);
+volatile uint8_t *sim_port(uint8_t port);
+
+// Intrinsics, called by the xc.h NOP(), SLEEP(), RESET() and delay macros.
+void sim_nop(void);
+void sim_sleep(void);
+void sim_reset(void) __attribute__((noreturn));
+void sim_delay(uint32_t cycles);
+
+/**
+ * Function: void sim_power_on(void)
+ *
+ * Reset the registers, peripherals, time and statistics to their power-on
+ * state with the oscillator at 48 MHz (as left by the USB bootloader). HEF
+ * contents and firmware variables are kept.
+ */
+void sim_power_on(void);
+
+/**
+ * Function: int sim_run(void (*entry)(void), double seconds)
+ *
+ * Run entry() for up to seconds of simulated time. Returns SIM_RETURNED,
+ * SIM_TIMEOUT, SIM_RESET or SIM_STOPPED. A power failure is simulated by a
+ * time limit that expires part way through a HEF erase or write.
+ */
+int sim_run(void (*)(void), double);
+
+/**
+ * Function: bool sim_isolate(void (*body)(void *data), void *data,
+ *                            size_t size)
+ *
+ * Run body(data) in a child process, so that it starts from the firmware
+ * variables as they are now and its changes to them are thrown away, and copy
+ * the size bytes at data back from the child. Returns false if the child
+ * failed.
+ */
+bool sim_isolate(void (*)(void *), void *, size_t);
+
+/**
+ * Function: void sim_stop(void)
+ *
+ * End sim_run() from a world model.
+ */
+void sim_stop(void) __attribute__((noreturn));
+
+/**
+ * Function: double sim_time(void)
+ *
+ * Return the simulated time since sim_power_on() in seconds.
+ */
+double sim_time(void);
+
+/**
+ * Function: double sim_cycle_time(void)
+ *
+ * Return the current instruction cycle period in seconds.
+ */
+double sim_cycle_time(void);
+
+/**
+ * Function: uint8_t sim_pin(uint8_t port, uint8_t bit)
+ *
+ * Return the level of a pin (port 0-2 for PORTA-PORTC), as driven by its
+ * latch or PWM output, or read from sim_input[] if it is an input.
+ */
+uint8_t sim_pin(uint8_t, uint8_t);
+
+/**
+ * Function: double sim_pin_duty(uint8_t port, uint8_t bit)
+ *
+ * Return the fraction of time a pin is high, averaged over a PWM period for
+ * the PWM outputs.
+ */
+double sim_pin_duty(uint8_t, uint8_t);
+
+/**
+ * Function: void sim_button(uint8_t sw, bool pressed)
+ *
+ * Press or release pushbutton SW1-SW5 (active-low inputs RA3 and RB4-RB7).
+ */
+void sim_button(uint8_t, bool);
+
+/**
+ * Function: void sim_hef_erase_all(void)
+ *
+ * Erase every HEF row and clear the wear counts.
+ */
+void sim_hef_erase_all(void);
+
+/**
+ * Functions: void sim_seed(uint32_t seed), uint32_t sim_random(void),
+ *            double sim_uniform(void), double sim_gauss(void)
+ *
+ * Repeatable pseudo-random numbers for world models: 32 random bits, a
+ * uniform value from 0 to 1, and a normally distributed value with a mean of
+ * 0 and a standard deviation of 1.
+ */
+void sim_seed(uint32_t);
+uint32_t sim_random(void);
+double sim_uniform(void);
+double sim_gauss(void);
+
+#endif
@@ -0,0 +1,621 @@
+/*==============================================================================
+ File: xc.h
+ Date: October 17, 2026
+
+ CHRP4 (PIC16F1459) host simulator hardware abstraction layer
+
+ Stands in for Microchip's xc.h when the firmware is compiled with gcc by the
+ host simulator Makefile (see sim.h). Each special function register is a byte
+ in sim_sfr[] reached through a macro with the XC8 register name, and each
+ register with named bits also has an XC8-style <register>bits union. Data
+ registers (latches, tristate and analog select registers, results) are
+ reached through sim_touch(), which only counts the access. Control, status and
+ timer registers are reached through sim_sync(), which brings the peripherals
+ up to date first and acts on the access (such as starting a conversion or
+ sending a byte) straight after it. Ports are read through sim_port(), which
+ works out the pin levels.
+
+ Bit names:
+ Control and status bits (GIE, ADIF, GO, WR...) are defined by their short
+ XC8 names, so use GIE rather than INTCONbits.GIE. Pin bits (RA3, LATC0,
+ TRISB6...) are only defined as members, so use PORTAbits.RA3 rather than RA3.
+ Writes to PORTx registers are ignored - write to LATx instead.
+
+ Integer sizes:
+ int is defined as short at the end of this file, so include system headers
+ before it (see sim.h).
+==============================================================================*/
+
+#ifndef SIM_XC_H
+#define SIM_XC_H
+
+#include    <stdint.h>
+#include    <stdbool.h>
+#include    <stdio.h>
+#include    <stdlib.h>
+#include    <string.h>
+
+#include    "sim.h"
+
+// Register access
+#define SIM_DATA(r)     (*sim_touch(&sim_sfr[SFR_##r]))
+#define SIM_CTRL(r)     (*sim_sync(&sim_sfr[SFR_##r]))
+#define SIM_DATA_BITS(r) (*(volatile r##bits_t *)sim_touch(&sim_sfr[SFR_##r]))
+#define SIM_CTRL_BITS(r) (*(volatile r##bits_t *)sim_sync(&sim_sfr[SFR_##r]))
+
+// Port, latch, tristate, analog select and pull-up bits
+typedef union
+{
+    struct
+    {
+        unsigned char RA0:1, RA1:1, RA2:1, RA3:1, RA4:1, RA5:1, :2;
+    };
+    uint8_t reg;
+} PORTAbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char :4, RB4:1, RB5:1, RB6:1, RB7:1;
+    };
+    uint8_t reg;
+} PORTBbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char RC0:1, RC1:1, RC2:1, RC3:1, RC4:1, RC5:1, RC6:1, RC7:1;
+    };
+    uint8_t reg;
+} PORTCbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char LATA0:1, LATA1:1, LATA2:1, LATA3:1, LATA4:1, LATA5:1, :2;
+    };
+    uint8_t reg;
+} LATAbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char :4, LATB4:1, LATB5:1, LATB6:1, LATB7:1;
+    };
+    uint8_t reg;
+} LATBbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char LATC0:1, LATC1:1, LATC2:1, LATC3:1,
+                      LATC4:1, LATC5:1, LATC6:1, LATC7:1;
+    };
+    uint8_t reg;
+} LATCbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char TRISA0:1, TRISA1:1, TRISA2:1, TRISA3:1,
+                      TRISA4:1, TRISA5:1, :2;
+    };
+    uint8_t reg;
+} TRISAbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char :4, TRISB4:1, TRISB5:1, TRISB6:1, TRISB7:1;
+    };
+    uint8_t reg;
+} TRISBbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char TRISC0:1, TRISC1:1, TRISC2:1, TRISC3:1,
+                      TRISC4:1, TRISC5:1, TRISC6:1, TRISC7:1;
+    };
+    uint8_t reg;
+} TRISCbits_t;
+
+// Interrupt, oscillator and reset bits
+typedef union
+{
+    struct
+    {
+        unsigned char IOCIF:1, INTF:1, TMR0IF:1, IOCIE:1,
+                      INTE:1, TMR0IE:1, PEIE:1, GIE:1;
+    };
+    uint8_t reg;
+} INTCONbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char TMR1IE:1, TMR2IE:1, :1, SSP1IE:1,
+                      TXIE:1, RCIE:1, ADIE:1, TMR1GIE:1;
+    };
+    uint8_t reg;
+} PIE1bits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char TMR1IF:1, TMR2IF:1, :1, SSP1IF:1,
+                      TXIF:1, RCIF:1, ADIF:1, TMR1GIF:1;
+    };
+    uint8_t reg;
+} PIR1bits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char :1, ACTIE:1, USBIE:1, BCL1IE:1,
+                      :1, C1IE:1, C2IE:1, OSFIE:1;
+    };
+    uint8_t reg;
+} PIE2bits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char :1, ACTIF:1, USBIF:1, BCL1IF:1,
+                      :1, C1IF:1, C2IF:1, OSFIF:1;
+    };
+    uint8_t reg;
+} PIR2bits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char PS:3, PSA:1, TMR0SE:1, TMR0CS:1, INTEDG:1, nWPUEN:1;
+    };
+    uint8_t reg;
+} OPTION_REGbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char SCS:2, IRCF:4, SPLLMULT:1, SPLLEN:1;
+    };
+    uint8_t reg;
+} OSCCONbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char HFIOFS:1, LFIOFR:1, MFIOFR:1, HFIOFL:1,
+                      HFIOFR:1, OSTS:1, PLLRDY:1, SOSCR:1;
+    };
+    uint8_t reg;
+} OSCSTATbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char nBOR:1, nPOR:1, nRI:1, nRMCLR:1,
+                      nRWDT:1, :1, STKUNF:1, STKOVF:1;
+    };
+    uint8_t reg;
+} PCONbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char SWDTEN:1, WDTPS:5, :2;
+    };
+    uint8_t reg;
+} WDTCONbits_t;
+
+// Timer bits
+typedef union
+{
+    struct
+    {
+        unsigned char TMR1ON:1, :1, nT1SYNC:1, T1OSCEN:1,
+                      T1CKPS:2, TMR1CS:2;
+    };
+    uint8_t reg;
+} T1CONbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char T2CKPS:2, TMR2ON:1, T2OUTPS:4, :1;
+    };
+    uint8_t reg;
+} T2CONbits_t;
+
+// ADC, voltage reference, DAC and comparator bits
+typedef union
+{
+    struct
+    {
+        unsigned char ADON:1, GO:1, CHS:5, :1;
+    };
+    struct
+    {
+        unsigned char :1, GO_nDONE:1, :6;
+    };
+    uint8_t reg;
+} ADCON0bits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char ADPREF:2, :2, ADCS:3, ADFM:1;
+    };
+    uint8_t reg;
+} ADCON1bits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char :4, TRIGSEL:4;
+    };
+    uint8_t reg;
+} ADCON2bits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char ADFVR:2, CDAFVR:2, TSRNG:1, TSEN:1, FVRRDY:1, FVREN:1;
+    };
+    uint8_t reg;
+} FVRCONbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char :2, DACPSS:2, DACOE2:1, DACOE1:1, :1, DACEN:1;
+    };
+    uint8_t reg;
+} DACCON0bits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char C1SYNC:1, C1HYS:1, C1SP:1, :1,
+                      C1POL:1, C1OE:1, C1OUT:1, C1ON:1;
+    };
+    uint8_t reg;
+} CM1CON0bits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char C2SYNC:1, C2HYS:1, C2SP:1, :1,
+                      C2POL:1, C2OE:1, C2OUT:1, C2ON:1;
+    };
+    uint8_t reg;
+} CM2CON0bits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char MC1OUT:1, MC2OUT:1, :6;
+    };
+    uint8_t reg;
+} CMOUTbits_t;
+
+// PWM bits
+typedef union
+{
+    struct
+    {
+        unsigned char :4, PWM1POL:1, PWM1OUT:1, PWM1OE:1, PWM1EN:1;
+    };
+    uint8_t reg;
+} PWM1CONbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char :4, PWM2POL:1, PWM2OUT:1, PWM2OE:1, PWM2EN:1;
+    };
+    uint8_t reg;
+} PWM2CONbits_t;
+
+// Interrupt-on-change bits
+typedef union
+{
+    struct
+    {
+        unsigned char IOCAF0:1, IOCAF1:1, :1, IOCAF3:1, IOCAF4:1, IOCAF5:1, :2;
+    };
+    uint8_t reg;
+} IOCAFbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char :4, IOCBF4:1, IOCBF5:1, IOCBF6:1, IOCBF7:1;
+    };
+    uint8_t reg;
+} IOCBFbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char :4, IOCBP4:1, IOCBP5:1, IOCBP6:1, IOCBP7:1;
+    };
+    uint8_t reg;
+} IOCBPbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char :4, IOCBN4:1, IOCBN5:1, IOCBN6:1, IOCBN7:1;
+    };
+    uint8_t reg;
+} IOCBNbits_t;
+
+// EUSART bits
+typedef union
+{
+    struct
+    {
+        unsigned char TX9D:1, TRMT:1, BRGH:1, SENDB:1,
+                      SYNC:1, TXEN:1, TX9:1, CSRC:1;
+    };
+    uint8_t reg;
+} TXSTAbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char RX9D:1, OERR:1, FERR:1, ADDEN:1,
+                      CREN:1, SREN:1, RX9:1, SPEN:1;
+    };
+    uint8_t reg;
+} RCSTAbits_t;
+
+typedef union
+{
+    struct
+    {
+        unsigned char ABDEN:1, WUE:1, :1, BRG16:1,
+                      SCKP:1, :1, RCIDL:1, ABDOVF:1;
+    };
+    uint8_t reg;
+} BAUDCONbits_t;
+
+// Program memory bits
+typedef union
+{
+    struct
+    {
+        unsigned char RD:1, WR:1, WREN:1, WRERR:1,
+                      FREE:1, LWLO:1, CFGS:1, :1;
+    };
+    uint8_t reg;
+} PMCON1bits_t;
+
+// Registers
+#define PORTA           (*sim_port(0))
+#define PORTB           (*sim_port(1))
+#define PORTC           (*sim_port(2))
+#define PORTAbits       (*(volatile PORTAbits_t *)sim_port(0))
+#define PORTBbits       (*(volatile PORTBbits_t *)sim_port(1))
+#define PORTCbits       (*(volatile PORTCbits_t *)sim_port(2))
+#define LATA            SIM_DATA(LATA)
+#define LATB            SIM_DATA(LATB)
+#define LATC            SIM_DATA(LATC)
+#define LATAbits        SIM_DATA_BITS(LATA)
+#define LATBbits        SIM_DATA_BITS(LATB)
+#define LATCbits        SIM_DATA_BITS(LATC)
+#define TRISA           SIM_DATA(TRISA)
+#define TRISB           SIM_DATA(TRISB)
+#define TRISC           SIM_DATA(TRISC)
+#define TRISAbits       SIM_DATA_BITS(TRISA)
+#define TRISBbits       SIM_DATA_BITS(TRISB)
+#define TRISCbits       SIM_DATA_BITS(TRISC)
+#define ANSELA          SIM_DATA(ANSELA)
+#define ANSELB          SIM_DATA(ANSELB)
+#define ANSELC          SIM_DATA(ANSELC)
+#define WPUA            SIM_DATA(WPUA)
+#define WPUB            SIM_DATA(WPUB)
+
+#define OPTION_REG      SIM_CTRL(OPTION_REG)
+#define OPTION_REGbits  SIM_CTRL_BITS(OPTION_REG)
+#define INTCON          SIM_CTRL(INTCON)
+#define INTCONbits      SIM_CTRL_BITS(INTCON)
+#define PIE1            SIM_CTRL(PIE1)
+#define PIE1bits        SIM_CTRL_BITS(PIE1)
+#define PIE2            SIM_CTRL(PIE2)
+#define PIE2bits        SIM_CTRL_BITS(PIE2)
+#define PIR1            SIM_CTRL(PIR1)
+#define PIR1bits        SIM_CTRL_BITS(PIR1)
+#define PIR2            SIM_CTRL(PIR2)
+#define PIR2bits        SIM_CTRL_BITS(PIR2)
+#define OSCCON          SIM_CTRL(OSCCON)
+#define OSCCONbits      SIM_CTRL_BITS(OSCCON)
+#define OSCSTAT         SIM_DATA(OSCSTAT)
+#define OSCSTATbits     SIM_DATA_BITS(OSCSTAT)
+#define ACTCON          SIM_DATA(ACTCON)
+#define PCON            SIM_DATA(PCON)
+#define PCONbits        SIM_DATA_BITS(PCON)
+#define WDTCON          SIM_DATA(WDTCON)
+#define WDTCONbits      SIM_DATA_BITS(WDTCON)
+
+#define TMR0            SIM_CTRL(TMR0)
+#define TMR1L           SIM_CTRL(TMR1L)
+#define TMR1H           SIM_CTRL(TMR1H)
+#define T1CON           SIM_CTRL(T1CON)
+#define T1CONbits       SIM_CTRL_BITS(T1CON)
+#define T1GCON          SIM_CTRL(T1GCON)
+#define TMR2            SIM_CTRL(TMR2)
+#define PR2             SIM_CTRL(PR2)
+#define T2CON           SIM_CTRL(T2CON)
+#define T2CONbits       SIM_CTRL_BITS(T2CON)
+
+#define ADCON0          SIM_CTRL(ADCON0)
+#define ADCON0bits      SIM_CTRL_BITS(ADCON0)
+#define ADCON1          SIM_CTRL(ADCON1)
+#define ADCON1bits      SIM_CTRL_BITS(ADCON1)
+#define ADCON2          SIM_CTRL(ADCON2)
+#define ADCON2bits      SIM_CTRL_BITS(ADCON2)
+#define ADRESL          SIM_DATA(ADRESL)
+#define ADRESH          SIM_DATA(ADRESH)
+#define FVRCON          SIM_CTRL(FVRCON)
+#define FVRCONbits      SIM_CTRL_BITS(FVRCON)
+#define DACCON0         SIM_CTRL(DACCON0)
+#define DACCON0bits     SIM_CTRL_BITS(DACCON0)
+#define DACCON1         SIM_CTRL(DACCON1)
+#define CM1CON0         SIM_CTRL(CM1CON0)
+#define CM1CON0bits     SIM_CTRL_BITS(CM1CON0)
+#define CM1CON1         SIM_CTRL(CM1CON1)
+#define CM2CON0         SIM_CTRL(CM2CON0)
+#define CM2CON0bits     SIM_CTRL_BITS(CM2CON0)
+#define CM2CON1         SIM_CTRL(CM2CON1)
+#define CMOUT           SIM_DATA(CMOUT)
+#define CMOUTbits       SIM_DATA_BITS(CMOUT)
+
+#define PWM1DCL         SIM_DATA(PWM1DCL)
+#define PWM1DCH         SIM_DATA(PWM1DCH)
+#define PWM1CON         SIM_CTRL(PWM1CON)
+#define PWM1CONbits     SIM_CTRL_BITS(PWM1CON)
+#define PWM2DCL         SIM_DATA(PWM2DCL)
+#define PWM2DCH         SIM_DATA(PWM2DCH)
+#define PWM2CON         SIM_CTRL(PWM2CON)
+#define PWM2CONbits     SIM_CTRL_BITS(PWM2CON)
+
+#define IOCAP           SIM_CTRL(IOCAP)
+#define IOCAN           SIM_CTRL(IOCAN)
+#define IOCAF           SIM_CTRL(IOCAF)
+#define IOCAFbits       SIM_CTRL_BITS(IOCAF)
+#define IOCBP           SIM_CTRL(IOCBP)
+#define IOCBPbits       SIM_CTRL_BITS(IOCBP)
+#define IOCBN           SIM_CTRL(IOCBN)
+#define IOCBNbits       SIM_CTRL_BITS(IOCBN)
+#define IOCBF           SIM_CTRL(IOCBF)
+#define IOCBFbits       SIM_CTRL_BITS(IOCBF)
+
+#define TXREG           SIM_CTRL(TXREG)
+#define RCREG           SIM_DATA(RCREG)
+#define SPBRGL          SIM_CTRL(SPBRGL)
+#define SPBRGH          SIM_CTRL(SPBRGH)
+#define SPBRG           SPBRGL
+#define RCSTA           SIM_CTRL(RCSTA)
+#define RCSTAbits       SIM_CTRL_BITS(RCSTA)
+#define TXSTA           SIM_CTRL(TXSTA)
+#define TXSTAbits       SIM_CTRL_BITS(TXSTA)
+#define BAUDCON         SIM_CTRL(BAUDCON)
+#define BAUDCONbits     SIM_CTRL_BITS(BAUDCON)
+
+#define PMADRL          SIM_DATA(PMADRL)
+#define PMADRH          SIM_DATA(PMADRH)
+#define PMDATL          SIM_DATA(PMDATL)
+#define PMDATH          SIM_DATA(PMDATH)
+#define PMCON1          SIM_CTRL(PMCON1)
+#define PMCON1bits      SIM_CTRL_BITS(PMCON1)
+#define PMCON2          SIM_CTRL(PMCON2)
+
+// Control and status bits
+#define GIE             INTCONbits.GIE
+#define PEIE            INTCONbits.PEIE
+#define TMR0IE          INTCONbits.TMR0IE
+#define INTE            INTCONbits.INTE
+#define IOCIE           INTCONbits.IOCIE
+#define TMR0IF          INTCONbits.TMR0IF
+#define INTF            INTCONbits.INTF
+#define IOCIF           INTCONbits.IOCIF
+#define TMR1IE          PIE1bits.TMR1IE
+#define TMR2IE          PIE1bits.TMR2IE
+#define TXIE            PIE1bits.TXIE
+#define RCIE            PIE1bits.RCIE
+#define ADIE            PIE1bits.ADIE
+#define TMR1IF          PIR1bits.TMR1IF
+#define TMR2IF          PIR1bits.TMR2IF
+#define TXIF            PIR1bits.TXIF
+#define RCIF            PIR1bits.RCIF
+#define ADIF            PIR1bits.ADIF
+#define C1IE            PIE2bits.C1IE
+#define C2IE            PIE2bits.C2IE
+#define C1IF            PIR2bits.C1IF
+#define C2IF            PIR2bits.C2IF
+#define HFIOFS          OSCSTATbits.HFIOFS
+#define LFIOFR          OSCSTATbits.LFIOFR
+#define MFIOFR          OSCSTATbits.MFIOFR
+#define HFIOFR          OSCSTATbits.HFIOFR
+#define PLLRDY          OSCSTATbits.PLLRDY
+#define SWDTEN          WDTCONbits.SWDTEN
+#define TMR1ON          T1CONbits.TMR1ON
+#define TMR2ON          T2CONbits.TMR2ON
+#define ADON            ADCON0bits.ADON
+#define GO              ADCON0bits.GO
+#define GO_nDONE        ADCON0bits.GO_nDONE
+#define ADFM            ADCON1bits.ADFM
+#define FVREN           FVRCONbits.FVREN
+#define FVRRDY          FVRCONbits.FVRRDY
+#define DACEN           DACCON0bits.DACEN
+#define MC1OUT          CMOUTbits.MC1OUT
+#define MC2OUT          CMOUTbits.MC2OUT
+#define TXEN            TXSTAbits.TXEN
+#define TRMT            TXSTAbits.TRMT
+#define BRGH            TXSTAbits.BRGH
+#define SPEN            RCSTAbits.SPEN
+#define CREN            RCSTAbits.CREN
+#define BRG16           BAUDCONbits.BRG16
+#define RD              PMCON1bits.RD
+#define WR              PMCON1bits.WR
+#define WREN            PMCON1bits.WREN
+#define WRERR           PMCON1bits.WRERR
+#define FREE            PMCON1bits.FREE
+#define LWLO            PMCON1bits.LWLO
+#define CFGS            PMCON1bits.CFGS
+#define IOCBF4          IOCBFbits.IOCBF4
+#define IOCBF5          IOCBFbits.IOCBF5
+#define IOCBF6          IOCBFbits.IOCBF6
+#define IOCBF7          IOCBFbits.IOCBF7
+
+// Compiler intrinsics and qualifiers
+#define NOP()           sim_nop()
+#define CLRWDT()        sim_nop()
+#define SLEEP()         sim_sleep()
+#define RESET()         sim_reset()
+#define di()            (GIE = 0)
+#define ei()            (GIE = 1)
+#define _delay(n)       sim_delay((uint32_t)(n))
+#define __delay_us(x)   sim_delay((uint32_t)((x) * (_XTAL_FREQ / 4000000.0)))
+#define __delay_ms(x)   sim_delay((uint32_t)((x) * (_XTAL_FREQ / 4000.0)))
+#define __interrupt(...)
+#define __persistent
+#define __at(address)
+
+// XC8 int and unsigned int are 16 bits wide
+#define int             short
+
+#endif